@@ -0,0 +1,355 @@
+/*******************************************************************************
+*
+*	Author:			Georg Bauer
+*	Date:			18.10.2026
+*
+*	Project-Title:	ClockWise
+*	Description:	Serial bootloader in the boot section
+*
+*	File-Title:		Bootloader
+*
+*******************************************************************************
+*
+* Pin Declaration:
+*	Pin						| Description
+*	------------------------|-------------------------------------------------
+*	PD0 (Pin 14) as input	| RXD USART 0 (pull-up)
+*	PD1 (Pin 15) as output	| TXD USART 0 (enabled with the first valid frame)
+*	------------------------|-------------------------------------------------
+*
+*******************************************************************************
+*
+* The bootloader is a project of its own (Bootloader.cproj), it's linked to
+* the boot section (.text=0xF000 words = 0x1E000 bytes) and programmed once
+* via SPI with BOOTRST programmed (see fuse settings in Code/main.c).
+* Afterwards the application is updated on usart 0 with Tools/upload.py.
+*
+* Start of application:
+* - watchdog reset: application starts at once (supervisor, see taskMgnt.c)
+* - power up or external reset: waits BOOT_WAIT_TIME for a host
+* - started by the application (console command 'boot', MCUSR is cleared
+*	by the application): waits BOOT_REQUEST_TIME for a host
+* - no application (erased reset vector): waits forever
+* The waiting time is counted from reset, bytes on RXD don't restart it. The
+* first valid frame starts a session, the bootloader stays until the
+* command BOOT_COMMAND_GO. The reset flags in MCUSR are kept for the
+* application (see captureResetFlags() in system.c). No interrupts are used.
+*
+* Protocol (16 bit values little endian, crc-16 xmodem: poly 0x1021, init 0):
+*	Host sends				| command, page (2), payload, crc (2)
+*	Bootloader replies		| status, payload, crc (2) (crc only with payload)
+* A frame with an unknown command byte is skipped byte by byte. Within a
+* session a wrong crc or a timeout between the bytes of a frame is answered
+* with BOOT_REPLY_RETRY and the host sends the frame again, before a session
+* it's ignored (the transmitter is still off, the host repeats its sync).
+*
+* A page is received completely to ram and checked before the flash page is
+* erased and written with the temporary page buffer (boot_page_fill()).
+* Afterwards the page is read back and compared. Pages of the boot section
+* are never written. The host writes page 0 (reset vector) as last page, so
+* an interrupted update leaves an erased reset vector and the bootloader
+* waits for the host after the next reset.
+*
+* IMPORTANT: TXD0 (PD1) is connected with the reset signal (RSTREG) of the
+* led matrix shift registers (see settings.h). Without a host the pin stays
+* an input, the led matrix is dark during an update anyway. For an update
+* RSTREG has to be tied to +5V, like for the console of the application.
+*
+* Entry: the console command 'boot' is only available in an application
+* built with USART0_ENABLED (disabled by default). Otherwise start
+* Tools/upload.py with --no-console and switch the clock off and on (or
+* reset it) while the tool is waiting, the bootloader answers within
+* BOOT_WAIT_TIME after power up.
+*
+*******************************************************************************
+*/
+
+//! Libraries
+#include "bootloader.h"
+
+//! Own global variables
+// received page
+uint8_t pageBuffer[SPM_PAGESIZE];
+// remaining waiting time for a host in ms since reset (0 means forever or session)
+uint16_t entryTime = BOOT_WAIT_TIME;
+
+//! Functional prototypes
+static uint8_t applicationValid(void);
+static void startApplication(void);
+static uint8_t receiveByte(uint8_t *data, uint16_t timeout);
+static void transmitByte(uint8_t data);
+static void transmitPayload(const uint8_t *data, uint16_t length);
+static uint8_t receiveFrame(uint8_t command, uint16_t *page);
+static uint8_t writePage(uint16_t page);
+static void readPage(uint16_t page);
+
+//! Main routine
+int main(void)
+{
+	uint8_t resetFlags = MCUSR;
+	uint8_t session = 0;
+	uint8_t command = 0;
+	uint16_t page = 0;
+	uint8_t info[BOOT_SYNC_SIZE];
+	
+	if(!applicationValid())
+	{
+		entryTime = 0;
+	}
+	else if(resetFlags & (1 << WDRF))
+	{
+		startApplication();
+	}
+	else if(!resetFlags)
+	{
+		entryTime = BOOT_REQUEST_TIME;
+	}
+	
+	// watchdog is still enabled after a watchdog reset without application
+	// or after a start by the application
+	MCUSR &= ~(1 << WDRF);
+	wdt_disable();
+	
+	// usart 0: receiver only, the transmitter is enabled with the first valid frame
+	PORTD |= (1 << PD0);
+	UBRR0 = BOOT_UBRR;
+	UCSR0C = (1 << UCSZ01) | (1 << UCSZ00);
+	UCSR0B = (1 << RXEN0);
+	
+	while(1)
+	{
+		// next command (without session the application starts at the end
+		// of the waiting time, see receiveByte())
+		receiveByte(&command, 0);
+		
+		if((command != BOOT_COMMAND_SYNC) && (command != BOOT_COMMAND_WRITE) &&
+			(command != BOOT_COMMAND_READ) && (command != BOOT_COMMAND_GO))
+		{
+			continue;
+		}
+		
+		if(!receiveFrame(command, &page))
+		{
+			// no reply before a session (transmitter off)
+			if(session)
+			{
+				transmitByte(BOOT_REPLY_RETRY);
+			}
+			continue;
+		}
+		
+		// first valid frame: start session, waiting time is over
+		if(!session)
+		{
+			UCSR0B |= (1 << TXEN0);
+			entryTime = 0;
+			session = 1;
+		}
+		
+		if(command == BOOT_COMMAND_SYNC)
+		{
+			info[0] = BOOT_VERSION;
+			info[1] = SIGNATURE_0;
+			info[2] = SIGNATURE_1;
+			info[3] = SIGNATURE_2;
+			info[4] = (uint8_t)BOOT_APPLICATION_PAGES;
+			info[5] = (uint8_t)(BOOT_APPLICATION_PAGES >> 8);
+			info[6] = (uint8_t)SPM_PAGESIZE;
+			info[7] = (uint8_t)(SPM_PAGESIZE >> 8);
+			transmitByte(BOOT_REPLY_OK);
+			transmitPayload(info, BOOT_SYNC_SIZE);
+		}
+		else if(command == BOOT_COMMAND_WRITE)
+		{
+			transmitByte(writePage(page));
+		}
+		else if(command == BOOT_COMMAND_READ)
+		{
+			if(page >= BOOT_APPLICATION_PAGES)
+			{
+				transmitByte(BOOT_REPLY_ERROR);
+				continue;
+			}
+			readPage(page);
+			transmitByte(BOOT_REPLY_OK);
+			transmitPayload(pageBuffer, SPM_PAGESIZE);
+		}
+		else
+		{
+			transmitByte(BOOT_REPLY_OK);
+			startApplication();
+		}
+	}
+	
+	return 0;
+}
+
+//! Check reset vector of application (erased flash is 0xFFFF)
+static uint8_t applicationValid(void)
+{
+	return pgm_read_word_far(0x0000) != 0xFFFF;
+}
+
+//! Start application at its reset vector, doesn't return
+static void startApplication(void)
+{
+	// wait for the last reply
+	if(UCSR0B & (1 << TXEN0))
+	{
+		while(!(UCSR0A & (1 << TXC0)));
+	}
+	
+	// usart 0 and pull-up back to reset values, the application initializes them
+	UCSR0B = 0;
+	UCSR0C = (1 << UCSZ01) | (1 << UCSZ00);
+	UBRR0 = 0;
+	PORTD &= ~(1 << PD0);
+	
+	asm volatile ("jmp 0x0000");
+}
+
+//! Receive a byte with a timeout in ms (0 means forever)
+// at the end of the waiting time since reset the application is started
+// return value is '1', means byte is received
+// return value is '0', means timeout
+static uint8_t receiveByte(uint8_t *data, uint16_t timeout)
+{
+	uint8_t step = 0;
+	
+	while(!(UCSR0A & (1 << RXC0)))
+	{
+		// 100 steps of 10us are 1ms
+		_delay_us(10);
+		if(++step < 100)
+		{
+			continue;
+		}
+		step = 0;
+		
+		// waiting time for a host is over (no session)
+		if(entryTime && !--entryTime)
+		{
+			startApplication();
+		}
+		if(timeout && !--timeout)
+		{
+			return 0;
+		}
+	}
+	*data = UDR0;
+	
+	return 1;
+}
+
+//! Transmit a byte (waits for the data register)
+static void transmitByte(uint8_t data)
+{
+	while(!(UCSR0A & (1 << UDRE0)));
+	// clear transmit complete flag, it's set after this byte
+	UCSR0A |= (1 << TXC0);
+	UDR0 = data;
+}
+
+//! Transmit payload of a reply with its crc
+static void transmitPayload(const uint8_t *data, uint16_t length)
+{
+	uint16_t crc = 0;
+	uint16_t i = 0;
+	
+	for(i = 0; i < length; i++)
+	{
+		transmitByte(data[i]);
+		crc = _crc_xmodem_update(crc, data[i]);
+	}
+	transmitByte((uint8_t)crc);
+	transmitByte((uint8_t)(crc >> 8));
+}
+
+//! Receive rest of a frame after the command byte, payload goes to pageBuffer
+// return value is '1', means frame is valid
+// return value is '0', means timeout or wrong crc
+static uint8_t receiveFrame(uint8_t command, uint16_t *page)
+{
+	uint16_t crc = _crc_xmodem_update(0, command);
+	uint16_t length = (command == BOOT_COMMAND_WRITE) ? SPM_PAGESIZE : 0;
+	uint16_t i = 0;
+	uint8_t data[4];
+	
+	// page
+	for(i = 0; i < 2; i++)
+	{
+		if(!receiveByte(&data[i], BOOT_BYTE_TIMEOUT))
+		{
+			return 0;
+		}
+		crc = _crc_xmodem_update(crc, data[i]);
+	}
+	*page = data[0] | ((uint16_t)data[1] << 8);
+	
+	// payload
+	for(i = 0; i < length; i++)
+	{
+		if(!receiveByte(&pageBuffer[i], BOOT_BYTE_TIMEOUT))
+		{
+			return 0;
+		}
+		crc = _crc_xmodem_update(crc, pageBuffer[i]);
+	}
+	
+	// crc
+	for(i = 2; i < 4; i++)
+	{
+		if(!receiveByte(&data[i], BOOT_BYTE_TIMEOUT))
+		{
+			return 0;
+		}
+	}
+	
+	return crc == (data[2] | ((uint16_t)data[3] << 8));
+}
+
+//! Write pageBuffer to a flash page of the application section and verify it
+// return value is BOOT_REPLY_OK or BOOT_REPLY_ERROR
+static uint8_t writePage(uint16_t page)
+{
+	uint32_t address = (uint32_t)page * SPM_PAGESIZE;
+	uint16_t i = 0;
+	
+	if(page >= BOOT_APPLICATION_PAGES)
+	{
+		return BOOT_REPLY_ERROR;
+	}
+	
+	boot_page_erase(address);
+	boot_spm_busy_wait();
+	for(i = 0; i < SPM_PAGESIZE; i += 2)
+	{
+		boot_page_fill(address + i, pageBuffer[i] | ((uint16_t)pageBuffer[i + 1] << 8));
+	}
+	boot_page_write(address);
+	boot_spm_busy_wait();
+	// application section is readable again
+	boot_rww_enable();
+	
+	for(i = 0; i < SPM_PAGESIZE; i++)
+	{
+		if(pgm_read_byte_far(address + i) != pageBuffer[i])
+		{
+			return BOOT_REPLY_ERROR;
+		}
+	}
+	
+	return BOOT_REPLY_OK;
+}
+
+//! Read a flash page of the application section to pageBuffer
+static void readPage(uint16_t page)
+{
+	uint32_t address = (uint32_t)page * SPM_PAGESIZE;
+	uint16_t i = 0;
+	
+	for(i = 0; i < SPM_PAGESIZE; i++)
+	{
+		pageBuffer[i] = pgm_read_byte_far(address + i);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+/*******************************************************************************
+*
+*	Author:			Georg Bauer
+*	Date:			18.10.2026
+*
+*	Project-Title:	ClockWise
+*	Description:	Serial bootloader in the boot section
+*
+*	File-Title:		Bootloader - Header File
+*
+*******************************************************************************
+*/
+
+// Oscillator with 16MHz, no clock division (see fuse settings in Code/main.c)
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+//! Libraries
+#include <avr/io.h>
+#include <avr/boot.h>
+#include <avr/pgmspace.h>
+#include <avr/wdt.h>
+#include <util/crc16.h>
+#include <util/delay.h>
+#include <stdint.h>
+
+//! Functional prototypes
+int main(void);
+
+//! Version of bootloader (reported by BOOT_COMMAND_SYNC)
+#define BOOT_VERSION				1
+
+//! Usart 0 with 38400 baud (8N1), like the console of the application
+// UBRR = 16MHz / (16 * 38400) - 1 = 25 (error 0,2%)
+#define BOOT_UBRR					25
+
+//! Application section: flash pages below the boot section (BOOTSZ = 4096W_F000)
+#define BOOT_SECTION_START			0x1E000UL	// byte address of boot section
+#define BOOT_APPLICATION_PAGES		(BOOT_SECTION_START / SPM_PAGESIZE)	// 480 pages
+
+//! Waiting time for a host in ms since reset (0 means forever)
+#define BOOT_WAIT_TIME				100		// after power up or external reset
+#define BOOT_REQUEST_TIME			10000	// started by the application (console command 'boot')
+#define BOOT_BYTE_TIMEOUT			50		// between the bytes of a frame
+
+//! Commands: command, page (2), payload, crc-16 (2) of command to payload
+#define BOOT_COMMAND_SYNC			'S'		// no payload, reply: version, signature (3), pages (2), page size (2)
+#define BOOT_COMMAND_WRITE			'W'		// page data as payload (SPM_PAGESIZE), reply: status only
+#define BOOT_COMMAND_READ			'R'		// no payload, reply: page data
+#define BOOT_COMMAND_GO				'G'		// no payload, reply: status, then the application starts
+
+//! Replies: status, payload of command, crc-16 (2) of payload (only with payload)
+#define BOOT_REPLY_OK				'K'		// command is done
+#define BOOT_REPLY_RETRY			'N'		// wrong crc or timeout, frame is dropped
+#define BOOT_REPLY_ERROR			'E'		// page outside application section or verify failed
+
+//! Size of sync reply
+#define BOOT_SYNC_SIZE				8
\ No newline at end of file
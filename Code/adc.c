@@ -18,53 +18,142 @@
 *	------------------------|-------------------------------------------------
 *
 *******************************************************************************
+*
+*	Interrupts:
+*	ADC conversion complete interrupt starts the next conversion. A round
+*	samples ADC_SAMPLES values of ADC0, ADC1 and the internal bandgap (1,1V
+*	against AVCC for the supply voltage). The first conversion after
+*	switching the multiplexer is thrown away. The sum is decimated
+*	to a 12 bit value and published with event EVENT_ADC_SAMPLE. A new round
+*	is started every ADC_PUBLISH_TIME by the adc thread.
+*
+*******************************************************************************
 */
 
 //! Libraries
 #include "adc.h"
+#include "settings.h"
+#include "events.h"
+#include "protothread.h"
+
+//! Own global variables
+// filtered 12 bit values of channels (published values)
+volatile uint16_t adcValue[ADC_CHANNELS];
+// sum of samples of actual channel
+volatile uint16_t adcSum;
+// number of samples of actual channel
+volatile uint8_t adcCount;
+// actual channel, ADC_CHANNELS if no round is running
+volatile uint8_t adcChannel;
+// multiplexer value of channels: ADC0, ADC1 and bandgap (MUX4:0 = 11110b)
+const uint8_t adcMux[ADC_CHANNELS] = {0x00, 0x01, 0x1E};
 
 //! Initialize ADC
 void initAdc(void)
 {
+	uint8_t i = 0;
+	
 	// use AVCC with exterenal capacitor at ARER pin (REFS0 = 1)
-	// result is reft adjust (ADLAR = 1)
-	ADMUX = (1 << REFS0) | (1 << ADLAR);
+	// result is right adjusted for 10 bit values (ADLAR = 0)
+	ADMUX = (1 << REFS0);
 		
-	// CLock prescaler of 128 (16MHz/8/128) = 15,625kHz
+	// CLock prescaler of 128 (16MHz/128) = 125kHz, 104us per conversion
 	ADCSRA = (1 << ADPS2)  | (1 << ADPS1) | (1 << ADPS0);
 	
-	// ADC enable (ADEN = 1)
-	ADCSRA |= (1 << ADEN);
+	// ADC enable (ADEN = 1) and conversion complete interrupt (ADIE = 1)
+	ADCSRA |= (1 << ADEN) | (1 << ADIE);
 	
-	// after active the adc, we need a dummy-readout
-	// to "warmup" the adc
-	(void) adcRead(0);
+	// no values available
+	for(i = 0; i<ADC_CHANNELS; i++)
+	{
+		adcValue[i] = 0;
+	}
+	
+	// first round starts after enabling global interrupts
+	// the first conversion "warms up" the adc (25 adc clock cycles)
+	adcChannel = ADC_CHANNELS;
+	startAdcRound();
 }
 
-//! Read ADC value
-// input value is channel number
-// output value is sampled value
-uint8_t adcRead(uint8_t channelSelection)
+//! Start a sampling round of all channels
+void startAdcRound(void)
 {
-	// select the corresponding channel 0~7
-	// ANDing with '7' will always keep the value
-	// of 'channelSelection' between 0 and 7
-	channelSelection &= 0b00000111;  // AND operation with 7
-	// clears the bottom 3 bits before ORing
-	ADMUX = (ADMUX & 0xF8) | channelSelection;
-		
+	// last round is still running
+	if(adcChannel < ADC_CHANNELS)
+	{
+		return;
+	}
+	
+	adcChannel = 0;
+	adcSum = 0;
+	adcCount = 0;
+	// select channel 0 (clears the bottom 5 bits)
+	ADMUX = (ADMUX & 0xE0) | adcMux[0];
 	// start single conversion
-	// write '1' to ADSC
 	ADCSRA |= (1 << ADSC);
-		
-	// wait for conversion to complete
-	// ADSC becomes '0' again
-	// till then, run loop continuously
-	while(ADCSRA & (1 << ADSC));
+}
+
+//! Get filtered 12 bit value of channel (range 0 to 4095), never blocks
+uint16_t getAdcValue(uint8_t channel)
+{
+	uint16_t value = 0;
+	
+	// 16 bit value is changed by interrupt service routine
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		value = adcValue[channel];
+	}
+	return value;
+}
+
+//! thread: start a sampling round every ADC_PUBLISH_TIME
+uint8_t threadAdc(void)
+{
+	static struct pt pt;
+	
+	PT_BEGIN(&pt);
+	
+	while(1)
 	{
-		// wait for value...
+		PT_SLEEP_MS(&pt, ADC_PUBLISH_TIME);
+		startAdcRound();
 	}
+	
+	PT_END(&pt);
+}
 
-	// return only 8 upper bits of 10 sampled bits
-	return ADCH;
+//! Interrupt Service Routine for when an adc conversion is complete
+// this routine will called every 104us while a round is running
+ISR(ADC_vect)
+{
+	// sum up samples (max. 64 * 1023 fits in 16 bit)
+	// the first conversion of a channel is thrown away (settling time)
+	if(adcCount)
+	{
+		adcSum += ADC;
+	}
+	adcCount++;
+	
+	// channel not complete: start next conversion
+	if(adcCount <= ADC_SAMPLES)
+	{
+		ADCSRA |= (1 << ADSC);
+		return;
+	}
+	
+	// decimation: 16 samples give 12 bit, more samples are filtered to 12 bit
+	adcValue[adcChannel] = adcSum >> (ADC_OVERSAMPLING - 2);
+	// tell main loop about new value
+	postEvent(EVENT_ADC_SAMPLE, adcChannel);
+	
+	// next channel
+	adcChannel++;
+	adcSum = 0;
+	adcCount = 0;
+	if(adcChannel < ADC_CHANNELS)
+	{
+		// select channel (clears the bottom 5 bits before ORing)
+		ADMUX = (ADMUX & 0xE0) | adcMux[adcChannel];
+		ADCSRA |= (1 << ADSC);
+	}
 }
\ No newline at end of file
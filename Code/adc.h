@@ -13,10 +13,19 @@
 
 //! Libraries
 #include <avr/io.h>
-//#include <avr/interrupt.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
 #include <stdint.h>
 #include <stdlib.h>
 
 //! Functional prototypes
 void initAdc(void);
-uint8_t adcRead(uint8_t channelSelection);
\ No newline at end of file
+void startAdcRound(void);
+uint16_t getAdcValue(uint8_t channel);
+uint8_t threadAdc(void);
+
+//! Channels
+#define ADC_CHANNEL_VDR			0	// ADC0: brightness VDR
+#define ADC_CHANNEL_TRIMMER		1	// ADC1: analog regulation trimmer
+#define ADC_CHANNEL_BANDGAP		2	// internal bandgap 1,1V (supply voltage)
+#define ADC_CHANNELS			3	// number of sampled channels
\ No newline at end of file
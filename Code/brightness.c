@@ -0,0 +1,383 @@
+/*******************************************************************************
+*
+*	Author:			Georg Bauer
+*	Date:			18.10.2026
+*
+*	Project-Title:	ClockWise
+*	Description:	Display brightness from light level, potentiometer and
+*					supply voltage
+*
+*	File-Title:		Brightness
+*
+*******************************************************************************
+*
+* Brightness pipeline:
+*	1. ambient filter: exponential moving average of the logarithmic light
+*	   value, actualized with every adc value (ADC_PUBLISH_TIME), mapped to
+*	   the light level (fixed or learned range) with hysteresis
+*	2. perceived lightness: light level and potentiometer are combined by
+*	   calcuateBrightness() (range 0 dark to 255 bright)
+*	3. slew limiter: the lightness follows the target with a maximum step
+*	   every BRIGHTNESS_SLEW_TIME, the CIE 1931 table converts it to the
+*	   pwm value of the display (systemConfig.displayBrightness)
+*
+*******************************************************************************
+*
+* Calibration of light level (display setting bit 4):
+*	The darkest and brightest filtered light values are learned. A new
+*	extreme is taken at once, every hour both ends decay by 1/168 towards the
+*	actual light value, so old extremes are forgotten after about 7 days.
+*	The learned range is saved in eeprom every hour (eeprom_update_block
+*	writes only changed bytes).
+*
+*******************************************************************************
+*
+* Supply voltage (brown out detection is disabled by the fuses):
+*	VCC = 1,1V * 4096 / bandgap value (12 bit), measured every adc round.
+*	Below SUPPLY_DERATE_START the maximum pwm value falls linear down to
+*	SUPPLY_DERATE_PWMVALUE at SUPPLY_DERATE_END. The limit is lifted again
+*	above SUPPLY_DERATE_RECOVER only. Below SUPPLY_DERATE_END only
+*	every second led of the matrix is lit (checkerboard). The lowest voltage
+*	and the number of drops below SUPPLY_DERATE_START are recorded.
+*
+*******************************************************************************
+*/
+
+//! Libraries
+#include "brightness.h"
+#include "settings.h"
+#include "system.h"
+#include "adc.h"
+#include "protothread.h"
+#include "nightMgnt.h"
+#include "telemetry.h"
+#include "ledMatrix.h"
+#include "log.h"
+#include <avr/eeprom.h>
+
+//! Own global variables
+// filtered light value in 1/512 octaves (1/32 octaves of calculateLightLog() * 16)
+int16_t ambientFiltered;
+// light level after hysteresis (range 0 dark to 255 bright)
+uint8_t ambientLevel;
+// actual perceived lightness of display (range 0 dark to 255 bright)
+uint8_t brightnessLevel;
+// learned range of light values
+struct lightCalibration calibration;
+// learned range of light values in eeprom
+struct lightCalibration eepromCalibration EEMEM;
+// supply voltage in mV
+uint16_t supplyVoltage;
+// lowest supply voltage in mV since start-up
+uint16_t supplyMinimum;
+// number of drops below SUPPLY_DERATE_START
+uint8_t supplyLowEvents;
+// maximum pwm value because of supply voltage
+uint8_t supplyPwmLimit;
+
+//! Functional prototypes
+static void actualizeSupply(void);
+
+// CIE 1931 lightness to pwm value: round(255 * Y(L*)), L* = i * 100 / 255
+const uint8_t cieLightness[256] PROGMEM =
+{
+	  0,   0,   0,   0,   0,   1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,
+	  2,   2,   2,   2,   2,   2,   2,   3,   3,   3,   3,   3,   3,   3,   3,   4,
+	  4,   4,   4,   4,   4,   5,   5,   5,   5,   5,   6,   6,   6,   6,   6,   7,
+	  7,   7,   7,   8,   8,   8,   8,   9,   9,   9,  10,  10,  10,  10,  11,  11,
+	 11,  12,  12,  12,  13,  13,  13,  14,  14,  15,  15,  15,  16,  16,  17,  17,
+	 17,  18,  18,  19,  19,  20,  20,  21,  21,  22,  22,  23,  23,  24,  24,  25,
+	 25,  26,  26,  27,  28,  28,  29,  29,  30,  31,  31,  32,  32,  33,  34,  34,
+	 35,  36,  37,  37,  38,  39,  39,  40,  41,  42,  43,  43,  44,  45,  46,  47,
+	 47,  48,  49,  50,  51,  52,  53,  54,  54,  55,  56,  57,  58,  59,  60,  61,
+	 62,  63,  64,  65,  66,  67,  68,  70,  71,  72,  73,  74,  75,  76,  77,  79,
+	 80,  81,  82,  83,  85,  86,  87,  88,  90,  91,  92,  94,  95,  96,  98,  99,
+	100, 102, 103, 105, 106, 108, 109, 110, 112, 113, 115, 116, 118, 120, 121, 123,
+	124, 126, 128, 129, 131, 132, 134, 136, 138, 139, 141, 143, 145, 146, 148, 150,
+	152, 154, 155, 157, 159, 161, 163, 165, 167, 169, 171, 173, 175, 177, 179, 181,
+	183, 185, 187, 189, 191, 193, 196, 198, 200, 202, 204, 207, 209, 211, 214, 216,
+	218, 220, 223, 225, 228, 230, 232, 235, 237, 240, 242, 245, 247, 250, 252, 255
+};
+
+//! Extern global variables
+extern volatile struct systemParameter systemConfig;
+
+//! Initialize brightness pipeline
+void initBrightness(void)
+{
+	// read learned range, take default range if eeprom is empty
+	eeprom_read_block(&calibration, &eepromCalibration, sizeof(calibration));
+	if((calibration.magic != CALIBRATION_MAGIC) || (calibration.bright <= calibration.dark))
+	{
+		calibration.magic	= CALIBRATION_MAGIC;
+		calibration.dark	= INTENSITY_LOG_DARK * 16;
+		calibration.bright	= INTENSITY_LOG_BRIGHT * 16;
+	}
+	
+	// start in the middle of the range, the learned range is not changed by the start-up
+	ambientFiltered = (calibration.dark / 2) + (calibration.bright / 2);
+	ambientLevel = systemConfig.lightIntensity;
+	brightnessLevel = calcuateBrightness(systemConfig.lightIntensity, systemConfig.potentiometerValue);
+	systemConfig.displayBrightness = calculatePwmValue(brightnessLevel);
+	
+	// no supply voltage measured yet
+	supplyVoltage = 5000;
+	supplyMinimum = 0xFFFF;
+	supplyLowEvents = 0;
+	supplyPwmLimit = PWMVALUE_MAXIMUM;
+}
+
+//! Actualize light level, potentiometer value or supply voltage with new filtered adc value of a channel
+// called by adc sample event, the display brightness follows in the brightness thread
+void actualizeBrightness(uint8_t channel)
+{
+	int16_t lightLog = 0;
+	uint8_t level = 0;
+#ifdef TELEMETRY_ENABLED
+	uint16_t value = getAdcValue(channel);
+	uint8_t data[3] = {channel, value, value >> 8};
+	
+	sendTelemetry(TELEMETRY_ADC, data, sizeof(data));
+#endif
+	
+	if(channel == ADC_CHANNEL_VDR)
+	{
+		// logarithmic light value of vdr (full adc resolution), 1/512 octaves
+		lightLog = calculateLightLog(getAdcValue(ADC_CHANNEL_VDR)) * 16;
+		
+		// exponential moving average: filtered += (value - filtered) / 2^BRIGHTNESS_FILTER_SHIFT
+		ambientFiltered += (lightLog - ambientFiltered) / (1 << BRIGHTNESS_FILTER_SHIFT);
+		
+		// automatic calibration: learn new extremes at once
+		if(systemConfig.displaySetting & 0x10)
+		{
+			if(ambientFiltered < calibration.dark)
+			{
+				calibration.dark = ambientFiltered;
+			}
+			if(ambientFiltered > calibration.bright)
+			{
+				calibration.bright = ambientFiltered;
+			}
+			level = calculateLightLevel(ambientFiltered / 16, calibration.dark / 16, calibration.bright / 16);
+		}
+		// fixed range
+		else
+		{
+			level = calculateLightLevel(ambientFiltered / 16, INTENSITY_LOG_DARK, INTENSITY_LOG_BRIGHT);
+		}
+		
+		// hysteresis: small changes (e.g. a passing shadow) are ignored
+		if((level > ambientLevel + BRIGHTNESS_HYSTERESIS) || (level + BRIGHTNESS_HYSTERESIS < ambientLevel))
+		{
+			ambientLevel = level;
+		}
+		systemConfig.lightIntensity = ambientLevel;
+	}
+	else if(channel == ADC_CHANNEL_TRIMMER)
+	{
+		// potentiometer value of trimmer
+		systemConfig.potentiometerValue = calculatePotiValue(getAdcValue(ADC_CHANNEL_TRIMMER) >> 4);
+	}
+	else
+	{
+		// supply voltage with internal bandgap
+		actualizeSupply();
+	}
+}
+
+//! Calculate supply voltage and derating of display
+static void actualizeSupply(void)
+{
+	uint16_t bandgap = getAdcValue(ADC_CHANNEL_BANDGAP);
+	uint8_t lastLimit = supplyPwmLimit;
+	
+	// no division by zero
+	if(bandgap < 1)
+	{
+		bandgap = 1;
+	}
+	// VCC = 1,1V * 4096 / bandgap
+	supplyVoltage = ((uint32_t)SUPPLY_BANDGAP * 4096) / bandgap;
+	
+	// record lowest voltage
+	if(supplyVoltage < supplyMinimum)
+	{
+		supplyMinimum = supplyVoltage;
+	}
+	
+	// derating of maximum pwm value (lifted only above recover voltage)
+	if((supplyVoltage >= SUPPLY_DERATE_RECOVER) || ((supplyVoltage >= SUPPLY_DERATE_START) && (lastLimit == PWMVALUE_MAXIMUM)))
+	{
+		supplyPwmLimit = PWMVALUE_MAXIMUM;
+	}
+	else if(supplyVoltage >= SUPPLY_DERATE_START)
+	{
+		// between start and recover voltage: keep last limit
+		supplyPwmLimit = lastLimit;
+	}
+	else if(supplyVoltage <= SUPPLY_DERATE_END)
+	{
+		supplyPwmLimit = SUPPLY_DERATE_PWMVALUE;
+	}
+	else
+	{
+		// linear between start and end voltage
+		supplyPwmLimit = SUPPLY_DERATE_PWMVALUE + (((uint32_t)(supplyVoltage - SUPPLY_DERATE_END) * (PWMVALUE_MAXIMUM - SUPPLY_DERATE_PWMVALUE)) / (SUPPLY_DERATE_START - SUPPLY_DERATE_END));
+	}
+	
+	// count drops below start voltage
+	if((lastLimit == PWMVALUE_MAXIMUM) && (supplyPwmLimit < PWMVALUE_MAXIMUM))
+	{
+		if(supplyLowEvents < 0xFF)
+		{
+			supplyLowEvents++;
+		}
+		logEvent(LOG_EVENT_SUPPLY_LOW, supplyVoltage);
+	}
+	
+	// reduce number of lit leds below end voltage (with hysteresis)
+	if(supplyVoltage < SUPPLY_DERATE_END)
+	{
+		setMatrixLedLimit(1);
+	}
+	else if(supplyVoltage > SUPPLY_DERATE_END + SUPPLY_HYSTERESIS)
+	{
+		setMatrixLedLimit(0);
+	}
+}
+
+//! Get supply voltage in mV
+uint16_t getSupplyVoltage(void)
+{
+	return supplyVoltage;
+}
+
+//! Get lowest supply voltage in mV since start-up
+uint16_t getSupplyMinimum(void)
+{
+	return supplyMinimum;
+}
+
+//! Get number of drops below SUPPLY_DERATE_START
+uint8_t getSupplyLowEvents(void)
+{
+	return supplyLowEvents;
+}
+
+//! Decay learned range of light values and save it, called by hour task
+void calibrateLightLevel(void)
+{
+	// calibration is inactive
+	if(!(systemConfig.displaySetting & 0x10))
+	{
+		return;
+	}
+	
+	// both ends decay towards the actual light value
+	if(ambientFiltered > calibration.dark)
+	{
+		calibration.dark += (ambientFiltered - calibration.dark) / CALIBRATION_DECAY_HOURS;
+	}
+	if(ambientFiltered < calibration.bright)
+	{
+		calibration.bright -= (calibration.bright - ambientFiltered) / CALIBRATION_DECAY_HOURS;
+	}
+	
+	// minimum range, a constant light must not amplify noise
+	if(calibration.bright - calibration.dark < CALIBRATION_MIN_RANGE * 16)
+	{
+		calibration.dark = ((calibration.dark + calibration.bright) / 2) - (CALIBRATION_MIN_RANGE * 8);
+		calibration.bright = calibration.dark + (CALIBRATION_MIN_RANGE * 16);
+	}
+	
+	// save learned range (only changed bytes are written)
+	eeprom_update_block(&calibration, &eepromCalibration, sizeof(calibration));
+}
+
+//! Calculate pwm value from perceived lightness (CIE 1931) with limitation
+uint8_t calculatePwmValue(uint8_t lightness)
+{
+	uint8_t pwmValue = pgm_read_byte(&cieLightness[lightness]);
+	
+	// limitation
+	if (pwmValue >= PWMVALUE_MAXIMUM)
+	{
+		pwmValue = PWMVALUE_MAXIMUM;
+	}
+	
+	if (pwmValue <= PWMVALUE_MINIMUM)
+	{
+		pwmValue = PWMVALUE_MINIMUM;
+	}
+	return pwmValue;
+}
+
+//! thread: slew limiter, actualizes display brightness every BRIGHTNESS_SLEW_TIME
+uint8_t threadBrightness(void)
+{
+	static struct pt pt;
+	uint8_t target = 0;
+	
+	PT_BEGIN(&pt);
+	
+	while(1)
+	{
+		PT_SLEEP_MS(&pt, BRIGHTNESS_SLEW_TIME);
+		
+		// target of perceived lightness
+		target = calcuateBrightness(systemConfig.lightIntensity, systemConfig.potentiometerValue);
+		
+		// limit change to BRIGHTNESS_SLEW_STEP
+		if(target > brightnessLevel)
+		{
+			if(target - brightnessLevel > BRIGHTNESS_SLEW_STEP)
+			{
+				brightnessLevel += BRIGHTNESS_SLEW_STEP;
+			}
+			else
+			{
+				brightnessLevel = target;
+			}
+		}
+		else
+		{
+			if(brightnessLevel - target > BRIGHTNESS_SLEW_STEP)
+			{
+				brightnessLevel -= BRIGHTNESS_SLEW_STEP;
+			}
+			else
+			{
+				brightnessLevel = target;
+			}
+		}
+		
+		// pwm value of display, used by timer 2
+		if(getNightState() == NIGHT_STATE_DIM)
+		{
+			// deep dim mode of night schedule
+			systemConfig.displayBrightness = NIGHT_DIM_PWMVALUE;
+		}
+		else
+		{
+			systemConfig.displayBrightness = calculatePwmValue(brightnessLevel);
+		}
+		
+		// derating because of low supply voltage
+		if(systemConfig.displayBrightness > supplyPwmLimit)
+		{
+			systemConfig.displayBrightness = supplyPwmLimit;
+		}
+		
+		// pwm value of each row with current limit
+		calculateRowDuty(systemConfig.displayBrightness);
+#ifdef TELEMETRY_ENABLED
+		{
+			uint8_t data[4] = {systemConfig.lightIntensity, systemConfig.potentiometerValue, brightnessLevel, systemConfig.displayBrightness};
+			sendTelemetry(TELEMETRY_BRIGHTNESS, data, sizeof(data));
+		}
+#endif
+	}
+	
+	PT_END(&pt);
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+/*******************************************************************************
+*
+*	Author:			Georg Bauer
+*	Date:			18.10.2026
+*
+*	Project-Title:	ClockWise
+*	Description:	Display brightness from light level, potentiometer and
+*					supply voltage
+*
+*	File-Title:		Brightness - Header File
+*
+*******************************************************************************
+*/
+
+//! Libraries
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include <stdint.h>
+
+//! Calibration Structure of light level
+struct lightCalibration
+{
+	uint8_t magic;		// CALIBRATION_MAGIC, if the values are valid
+	int16_t dark;		// darkest light value in 1/512 octaves
+	int16_t bright;		// brightest light value in 1/512 octaves
+};
+
+//! Functional prototypes
+void initBrightness(void);
+void actualizeBrightness(uint8_t channel);
+void calibrateLightLevel(void);
+uint16_t getSupplyVoltage(void);
+uint16_t getSupplyMinimum(void);
+uint8_t getSupplyLowEvents(void);
+uint8_t calculatePwmValue(uint8_t lightness);
+uint8_t threadBrightness(void);
+
+//! Calibration
+#define CALIBRATION_MAGIC		0x5A	// marker of valid values in eeprom
\ No newline at end of file
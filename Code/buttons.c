@@ -0,0 +1,192 @@
+/*******************************************************************************
+*
+*	Author:			Georg Bauer
+*	Date:			18.10.2026
+*
+*	Project-Title:	ClockWise
+*	Description:	Debounced switches with press and release events
+*
+*	File-Title:		Buttons
+*
+*******************************************************************************
+*
+* The four switches (PA2 to PA5, see gpios.c) are sampled every 5ms. Every
+* switch has a shift register of its last samples, a switch is pressed when
+* the last samples (BUTTON_DEBOUNCE_MASK) are all high and released when
+* they are all low. Bouncing contacts keep the old state.
+*
+* A switch hold for BUTTON_LONG_TIME is a long press. Up and down repeat
+* after a long press with increasing speed: BUTTON_REPEAT_SLOW_COUNT repeats
+* at 2/s, BUTTON_REPEAT_MEDIUM_COUNT repeats at 8/s and then 20/s.
+*
+* Events (see events.h):
+*	EVENT_BUTTON			switch pressed or repeated (up and down),
+*							data: state of all switches or repeated switch
+*	EVENT_BUTTON_RELEASE	switch released, data: released switches
+*	EVENT_BUTTON_LONG		switches hold for BUTTON_LONG_TIME, data: state
+*
+*	Switch bits: bit 0 cancel, bit 1 down, bit 2 up, bit 3 ok
+*
+*******************************************************************************
+*
+*	Timer:
+*	Timer 3 is free running with prescaler 64 -> 4us per tick, overflow 262ms
+*	(used by the task profiler as well), compare match b every BUTTON_SAMPLE_TIME
+*
+*******************************************************************************
+*/
+
+//! Libraries
+#include "buttons.h"
+#include "settings.h"
+#include "events.h"
+
+//! Own global variables
+// last samples of each switch (bit 0 is the newest sample)
+volatile uint8_t buttonHistory[4];
+// debounced state of switches
+volatile uint8_t buttonState;
+// samples since last change of state (saturated)
+uint8_t buttonHoldTime;
+// samples until next repeat
+uint8_t buttonRepeatTime;
+// number of repeats (saturated)
+uint8_t buttonRepeats;
+
+//! Initialize button driver
+void initButtons(void)
+{
+	uint8_t i = 0;
+	
+	// all switches released
+	for(i = 0; i < 4; i++)
+	{
+		buttonHistory[i] = 0;
+	}
+	buttonState = 0;
+	buttonHoldTime = 0;
+	buttonRepeatTime = 0;
+	buttonRepeats = 0;
+	
+	//! free running timer for sampling (and timestamps of profiler)
+	// 16 bit timer/counter 3, normal mode
+	TCCR3A = 0;
+	// clock select: prescaler 64 -> 4us per tick
+	TCCR3B = (1 << CS31) | (1 << CS30);
+	// first sample
+	OCR3B = TCNT3 + BUTTON_SAMPLE_TIME;
+	// enable output compare match b interrupt
+	TIMSK3 |= (1 << OCIE3B);
+}
+
+//! Get debounced state of switches
+uint8_t getButtonState(void)
+{
+	return buttonState;
+}
+
+//! Interrupt Service Routine when Timer/Counter 3 has an compare match b
+// this routine will called every BUTTON_SAMPLE_TIME * 4us (5ms)
+ISR(TIMER3_COMPB_vect)
+{
+	uint8_t i = 0;
+	uint8_t switches = 0;
+	uint8_t newState = buttonState;
+	uint8_t changed = 0;
+	
+	// next sample
+	OCR3B += BUTTON_SAMPLE_TIME;
+	
+	// get value of switch 1, 2, 3 and 4 - masking with 0011.1100b and shift to right
+	switches = (PINA & 0x3C) >> 2;
+	
+	for(i = 0; i < 4; i++)
+	{
+		// shift in new sample
+		buttonHistory[i] = (buttonHistory[i] << 1) | ((switches >> i) & 0x01);
+		
+		// stable high: pressed
+		if((buttonHistory[i] & BUTTON_DEBOUNCE_MASK) == BUTTON_DEBOUNCE_MASK)
+		{
+			newState |= (1 << i);
+		}
+		// stable low: released
+		else if(!(buttonHistory[i] & BUTTON_DEBOUNCE_MASK))
+		{
+			newState &= ~(1 << i);
+		}
+	}
+	
+	// post new presses with state of all switches (e.g. ok and cancel together)
+	changed = newState & ~buttonState;
+	if(changed)
+	{
+		postEvent(EVENT_BUTTON, newState);
+	}
+	
+	// post releases
+	changed = buttonState & ~newState;
+	if(changed)
+	{
+		postEvent(EVENT_BUTTON_RELEASE, changed);
+	}
+	
+	// new state: start hold time
+	if(newState != buttonState)
+	{
+		buttonState = newState;
+		buttonHoldTime = 0;
+		buttonRepeats = 0;
+		return;
+	}
+	
+	// no switch is hold
+	if(!buttonState)
+	{
+		return;
+	}
+	
+	// count hold time
+	if(buttonHoldTime < 0xFF)
+	{
+		buttonHoldTime++;
+	}
+	
+	// long press
+	if(buttonHoldTime == BUTTON_LONG_TIME)
+	{
+		postEvent(EVENT_BUTTON_LONG, buttonState);
+		buttonRepeatTime = 0;
+	}
+	
+	// auto repeat of up and down after long press
+	if((buttonHoldTime >= BUTTON_LONG_TIME) && (buttonState & (BUTTON_UP | BUTTON_DOWN)))
+	{
+		if(buttonRepeatTime)
+		{
+			buttonRepeatTime--;
+			return;
+		}
+		
+		postEvent(EVENT_BUTTON, buttonState & (BUTTON_UP | BUTTON_DOWN));
+		
+		// speed up: 2/s, 8/s and 20/s
+		if(buttonRepeats < 0xFF)
+		{
+			buttonRepeats++;
+		}
+		// samples to wait: the repeat follows in the sample after the last one
+		if(buttonRepeats < BUTTON_REPEAT_SLOW_COUNT)
+		{
+			buttonRepeatTime = BUTTON_REPEAT_SLOW - 1;
+		}
+		else if(buttonRepeats < BUTTON_REPEAT_SLOW_COUNT + BUTTON_REPEAT_MEDIUM_COUNT)
+		{
+			buttonRepeatTime = BUTTON_REPEAT_MEDIUM - 1;
+		}
+		else
+		{
+			buttonRepeatTime = BUTTON_REPEAT_FAST - 1;
+		}
+	}
+}
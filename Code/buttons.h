@@ -0,0 +1,27 @@
+/*******************************************************************************
+*
+*	Author:			Georg Bauer
+*	Date:			18.10.2026
+*
+*	Project-Title:	ClockWise
+*	Description:	Debounced switches with press and release events
+*
+*	File-Title:		Buttons - Header File
+*
+*******************************************************************************
+*/
+
+//! Libraries
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <stdint.h>
+
+//! Functional prototypes
+void initButtons(void);
+uint8_t getButtonState(void);
+
+//! Switches
+#define BUTTON_CANCEL				0x01	// switch 1
+#define BUTTON_DOWN					0x02	// switch 2
+#define BUTTON_UP					0x04	// switch 3
+#define BUTTON_OK					0x08	// switch 4
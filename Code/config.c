@@ -0,0 +1,176 @@
+/*******************************************************************************
+*
+*	Author:			Georg Bauer
+*	Date:			18.10.2026
+*
+*	Project-Title:	ClockWise
+*	Description:	Configuration in eeprom with crc and wear levelling
+*
+*	File-Title:		Configuration
+*
+*******************************************************************************
+*
+* The values set in the menu (time mode, display settings, manual display
+* brightness and pie shift) are saved as record (struct configRecord) in
+* the eeprom. A record has a layout version, a write counter (sequence) and
+* a crc-8 (ccitt) of all other bytes.
+*
+* Wear levelling: the records are written round robin to CONFIG_SLOTS slots
+* (eepromConfig, placed by the linker like the light calibration). At boot
+* all slots are read, the valid slot (version and crc) with the highest
+* sequence (8 bit, serial number arithmetic) is the newest one. A record is
+* only written, if a value has changed, and the eeprom only writes changed
+* bytes (eeprom_update_byte).
+*
+* The record is written by threadConfig() byte by byte, a byte takes 3,4ms
+* and the thread waits for the eeprom without blocking the main loop. The
+* crc is written last: an interrupted write leaves an invalid slot and the
+* older slot stays the newest one.
+*
+*******************************************************************************
+*/
+
+//! Libraries
+#include "config.h"
+#include "settings.h"
+#include "system.h"
+#include "protothread.h"
+
+//! Own global variables
+// slots of configuration in eeprom
+struct configRecord eepromConfig[CONFIG_SLOTS] EEMEM;
+// last loaded or saved record
+struct configRecord configActual;
+// slot of last loaded or saved record
+uint8_t configSlot;
+// record to write and its slot, write is pending
+struct configRecord configWrite;
+uint8_t configWriteSlot;
+uint8_t configPending;
+
+//! Extern global variables
+extern volatile struct systemParameter systemConfig;
+
+//! Load newest valid configuration from eeprom, called after initSystem()
+// without a valid slot the default values of initSystem() are kept
+void initConfig(void)
+{
+	struct configRecord record;
+	uint8_t i = 0;
+	
+	configSlot = CONFIG_SLOT_NONE;
+	configPending = 0;
+	
+	// search newest valid slot
+	for(i = 0; i < CONFIG_SLOTS; i++)
+	{
+		eeprom_read_block(&record, &eepromConfig[i], sizeof(record));
+		
+		if((record.version != CONFIG_VERSION) || (record.crc != calculateConfigCrc(&record)))
+		{
+			continue;
+		}
+		if((configSlot == CONFIG_SLOT_NONE) || ((int8_t)(record.sequence - configActual.sequence) > 0))
+		{
+			configActual = record;
+			configSlot = i;
+		}
+	}
+	
+	// no valid slot: first write goes to slot 0
+	if(configSlot == CONFIG_SLOT_NONE)
+	{
+		configActual.version = CONFIG_VERSION;
+		configActual.sequence = 0;
+		configActual.status = systemConfig.status & CONFIG_STATUS_MASK;
+		configActual.displaySetting = systemConfig.displaySetting;
+		configActual.manualBrightness = systemConfig.manualBrightness;
+		configActual.pieShift = systemConfig.pieShift;
+		configSlot = CONFIG_SLOTS - 1;
+		return;
+	}
+	
+	// take saved values
+	systemConfig.status = (systemConfig.status & ~CONFIG_STATUS_MASK) | (configActual.status & CONFIG_STATUS_MASK);
+	systemConfig.displaySetting = configActual.displaySetting;
+	systemConfig.manualBrightness = configActual.manualBrightness;
+	if((configActual.pieShift >= 1) && (configActual.pieShift <= PIE_SHIFT_MAXIMUM))
+	{
+		systemConfig.pieShift = configActual.pieShift;
+	}
+}
+
+//! Save configuration to next slot, if a value has changed (called when menu is left)
+void saveConfig(void)
+{
+	struct configRecord record = configActual;
+	
+	record.status = systemConfig.status & CONFIG_STATUS_MASK;
+	record.displaySetting = systemConfig.displaySetting;
+	record.manualBrightness = systemConfig.manualBrightness;
+	record.pieShift = systemConfig.pieShift;
+	
+	// nothing changed: no write
+	if((record.status == configActual.status) &&
+	   (record.displaySetting == configActual.displaySetting) &&
+	   (record.manualBrightness == configActual.manualBrightness) &&
+	   (record.pieShift == configActual.pieShift))
+	{
+		return;
+	}
+	
+	// next slot with next sequence
+	record.sequence++;
+	record.crc = calculateConfigCrc(&record);
+	configSlot = (configSlot + 1) % CONFIG_SLOTS;
+	configActual = record;
+	
+	// written by config thread
+	configWrite = record;
+	configWriteSlot = configSlot;
+	configPending = 1;
+}
+
+//! Calculate crc-8 (ccitt) of a record, all bytes without the crc
+uint8_t calculateConfigCrc(const struct configRecord *record)
+{
+	const uint8_t *data = (const uint8_t *)record;
+	uint8_t crc = 0;
+	uint8_t i = 0;
+	
+	for(i = 0; i < sizeof(struct configRecord) - 1; i++)
+	{
+		crc = _crc8_ccitt_update(crc, data[i]);
+	}
+	return crc;
+}
+
+//! thread: write pending record byte by byte, waits for the eeprom
+uint8_t threadConfig(void)
+{
+	static struct pt pt;
+	static struct configRecord record;
+	static uint8_t *address;
+	static uint8_t i;
+	
+	PT_BEGIN(&pt);
+	
+	while(1)
+	{
+		PT_WAIT_UNTIL(&pt, configPending);
+		
+		// a new save during the write is written afterwards to the next slot
+		record = configWrite;
+		address = (uint8_t *)&eepromConfig[configWriteSlot];
+		configPending = 0;
+		
+		// crc is the last byte of the record
+		for(i = 0; i < sizeof(record); i++)
+		{
+			PT_WAIT_UNTIL(&pt, eeprom_is_ready());
+			eeprom_update_byte(address + i, ((uint8_t *)&record)[i]);
+		}
+	}
+	
+	PT_END(&pt);
+}
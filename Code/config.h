@@ -0,0 +1,41 @@
+/*******************************************************************************
+*
+*	Author:			Georg Bauer
+*	Date:			18.10.2026
+*
+*	Project-Title:	ClockWise
+*	Description:	Configuration in eeprom with crc and wear levelling
+*
+*	File-Title:		Configuration - Header File
+*
+*******************************************************************************
+*/
+
+//! Libraries
+#include <avr/io.h>
+#include <avr/eeprom.h>
+#include <util/crc16.h>
+#include <stdint.h>
+
+//! record of configuration in one eeprom slot
+struct configRecord
+{
+	uint8_t version;			// layout of record (CONFIG_VERSION)
+	uint8_t sequence;			// write counter, newest slot has the highest value
+	uint8_t status;				// time mode (bit 4 of system status)
+	uint8_t displaySetting;		// display settings (see system.h)
+	uint8_t manualBrightness;	// manual display brightness
+	uint8_t pieShift;			// shift of pie in minutes
+	uint8_t crc;				// crc-8 of all bytes before
+};
+
+//! Functional prototypes
+void initConfig(void);
+void saveConfig(void);
+uint8_t calculateConfigCrc(const struct configRecord *record);
+uint8_t threadConfig(void);
+
+//! Record layout
+#define CONFIG_VERSION				1		// has to be changed with struct configRecord
+#define CONFIG_STATUS_MASK			0x10	// saved bits of system status
+#define CONFIG_SLOT_NONE			0xFF	// no valid slot in eeprom
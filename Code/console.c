@@ -0,0 +1,487 @@
+/*******************************************************************************
+*
+*	Author:			Georg Bauer
+*	Date:			18.10.2026
+*
+*	Project-Title:	ClockWise
+*	Description:	Command console on usart 0
+*
+*	File-Title:		Console
+*
+*******************************************************************************
+*
+* Line oriented console on usart 0 (38400 baud, 8N1, see settings.h), a
+* line ends with CR (LF is ignored), backspace deletes the last character:
+*	Command					| Description
+*	------------------------|-------------------------------------------------
+*	help					| list of commands
+*	time					| system time: hh:mm:ss dd.mm.yy weekday
+*	time 12:34:56 18.10.26 7| set manual time (like menu, stops dcf77)
+*	config					| status, display settings, manual brightness
+*							| and pie shift
+*	dcf						| received frames, accepted frames and rejected
+*							| frames (parity minute, hour, date, plausibility)
+*	sync					| automatic time mode, searches dcf77 signal
+*	bright auto				| automatic display brightness
+*	bright 0 ... 255		| manual display brightness
+*	log						| dump of event log (see Tools/logdecode.py)
+*	prof					| dump of task profiles (TASK_PROFILING only)
+*	tele on, tele off		| start or stop binary telemetry stream
+*							| (TELEMETRY_ENABLED only, see telemetry.c)
+*	boot					| start serial bootloader for a firmware update
+*							| (see Tools/upload.py)
+*	------------------------|-------------------------------------------------
+* Numbers are decimal, status and display settings hexadecimal. A command
+* answers 'ok', 'error' (wrong arguments) or 'busy' (menu is active).
+*
+* All output goes to the transmit buffer of usart 0 and never waits for the
+* serial line. The console thread waits for CONSOLE_OUTPUT_SPACE free bytes
+* before every line (the longest line and the prompt fit), the dumps are
+* sent line by line.
+*
+*******************************************************************************
+*/
+
+//! Libraries
+#include "console.h"
+#include "settings.h"
+#include "system.h"
+#include "protothread.h"
+#include "usart.h"
+#include "menu.h"
+#include "dcf77.h"
+#include "config.h"
+#include "log.h"
+#include "profiler.h"
+#include "displayMatrix.h"
+#include "telemetry.h"
+
+#ifdef USART0_ENABLED
+
+//! Own global variables
+// command words
+const struct consoleCommand consoleCommands[] PROGMEM =
+{
+	{"help", CONSOLE_COMMAND_HELP},
+	{"time", CONSOLE_COMMAND_TIME},
+	{"config", CONSOLE_COMMAND_CONFIG},
+	{"dcf", CONSOLE_COMMAND_DCF},
+	{"sync", CONSOLE_COMMAND_SYNC},
+	{"bright", CONSOLE_COMMAND_BRIGHT},
+	{"log", CONSOLE_COMMAND_LOG},
+#ifdef TASK_PROFILING
+	{"prof", CONSOLE_COMMAND_PROFILE},
+#endif
+#ifdef TELEMETRY_ENABLED
+	{"tele", CONSOLE_COMMAND_TELEMETRY},
+#endif
+	{"boot", CONSOLE_COMMAND_BOOT},
+};
+// received command line
+char consoleLine[CONSOLE_LINE_SIZE];
+uint8_t consoleLength;
+// start of arguments in command line
+uint8_t consoleArgument;
+// command to execute (from command line or menu)
+uint8_t consoleCommand;
+
+//! Extern global variables
+extern volatile struct systemParameter systemConfig;
+extern volatile struct time systemTime;
+extern volatile struct time setTime;
+extern struct dcfStatistics dcfStatistics;
+
+//! Functional prototypes
+static uint8_t readConsoleLine(void);
+static uint8_t parseConsoleLine(void);
+static uint8_t parseConsoleNumbers(uint8_t *values, uint8_t count);
+static void executeConsoleCommand(uint8_t command);
+static void consoleSetTime(void);
+static void consoleSetBrightness(void);
+
+//! Initialize console and send first prompt
+void initConsole(void)
+{
+	consoleLength = 0;
+	consoleArgument = 0;
+	consoleCommand = CONSOLE_COMMAND_NONE;
+	
+	usart0TransmitText(PSTR("\r\n> "));
+}
+
+//! Request a command (called by menu), ignored while a command is running
+void requestConsoleCommand(uint8_t command)
+{
+	if(consoleCommand == CONSOLE_COMMAND_NONE)
+	{
+		consoleCommand = command;
+		consoleArgument = 0;
+	}
+}
+
+//! Thread of console: read command lines and execute them
+uint8_t threadConsole(void)
+{
+	static struct pt pt;
+	static uint8_t i;
+	static uint8_t head;
+	
+	PT_BEGIN(&pt);
+	
+	while(1)
+	{
+		// wait for a command line or a request of the menu
+		PT_WAIT_UNTIL(&pt, consoleCommand || readConsoleLine());
+		if(consoleCommand == CONSOLE_COMMAND_NONE)
+		{
+			consoleCommand = parseConsoleLine();
+		}
+		
+		// dumps are sent line by line
+		if(consoleCommand == CONSOLE_COMMAND_LOG)
+		{
+			// entries in ram are written first, the oldest entry is kept
+			// for the whole dump (later writes don't shift the lines)
+			flushLog();
+			PT_WAIT_UNTIL(&pt, !getLogPending());
+			head = getLogHead();
+			for(i = 0; i < LOG_ENTRIES; i++)
+			{
+				PT_WAIT_UNTIL(&pt, getUsart0Free() >= CONSOLE_OUTPUT_SPACE);
+				dumpLog((head + i) % LOG_ENTRIES);
+			}
+		}
+#ifdef TASK_PROFILING
+		else if(consoleCommand == CONSOLE_COMMAND_PROFILE)
+		{
+			for(i = 0; i < PROFILE_COUNT; i++)
+			{
+				PT_WAIT_UNTIL(&pt, getUsart0Free() >= CONSOLE_OUTPUT_SPACE);
+				profileDump(i);
+			}
+		}
+#endif
+		// bootloader starts after the reply is sent (doesn't return)
+		else if(consoleCommand == CONSOLE_COMMAND_BOOT)
+		{
+#ifdef TELEMETRY_ENABLED
+			// no more frames, the transmit buffer runs empty
+			setTelemetry(0);
+#endif
+			PT_WAIT_UNTIL(&pt, getUsart0Free() >= CONSOLE_OUTPUT_SPACE);
+			usart0TransmitText(PSTR("ok\r\n"));
+			PT_WAIT_UNTIL(&pt, getUsart0Free() == USART0_TX_BUFFER_SIZE);
+			startBootloader();
+		}
+		else
+		{
+			PT_WAIT_UNTIL(&pt, getUsart0Free() >= CONSOLE_OUTPUT_SPACE);
+			executeConsoleCommand(consoleCommand);
+		}
+		
+		// prompt for next command
+		usart0TransmitText(PSTR("> "));
+		consoleCommand = CONSOLE_COMMAND_NONE;
+	}
+	
+	PT_END(&pt);
+}
+
+//! Read received characters into command line (with echo)
+// return value is '1', means a complete line is in 'consoleLine'
+// return value is '0', means the line is not complete
+static uint8_t readConsoleLine(void)
+{
+	uint8_t data = 0;
+	
+	while(usart0Receive(&data))
+	{
+		// end of line (the rest stays in the receive buffer)
+		if(data == '\r')
+		{
+			consoleLine[consoleLength] = 0;
+			usart0TransmitText(PSTR("\r\n"));
+			return 1;
+		}
+		
+		// backspace or delete: remove last character
+		if((data == '\b') || (data == 0x7F))
+		{
+			if(consoleLength)
+			{
+				consoleLength--;
+				usart0TransmitText(PSTR("\b \b"));
+			}
+		}
+		// printable character (line feed and other control characters are ignored)
+		else if((data >= ' ') && (data < 0x7F) && (consoleLength < CONSOLE_LINE_SIZE - 1))
+		{
+			consoleLine[consoleLength++] = data;
+			usart0Transmit(data);
+		}
+	}
+	return 0;
+}
+
+//! Search command word of command line
+// output: command (see CONSOLE_COMMAND_*), 'consoleArgument' is set
+static uint8_t parseConsoleLine(void)
+{
+	uint8_t i = 0;
+	uint8_t length = 0;
+	
+	// next line starts empty
+	consoleLength = 0;
+	
+	// command word ends at first space, arguments start after it
+	while(consoleLine[length] && (consoleLine[length] != ' '))
+	{
+		length++;
+	}
+	if(!length)
+	{
+		return CONSOLE_COMMAND_NONE;
+	}
+	consoleArgument = length;
+	if(consoleLine[length])
+	{
+		consoleLine[length] = 0;
+		consoleArgument++;
+	}
+	
+	for(i = 0; i < sizeof(consoleCommands) / sizeof(consoleCommands[0]); i++)
+	{
+		if(!strcmp_P(consoleLine, consoleCommands[i].name))
+		{
+			return pgm_read_byte(&consoleCommands[i].command);
+		}
+	}
+	return CONSOLE_COMMAND_UNKNOWN;
+}
+
+//! Read decimal numbers (0 to 255) of arguments, any other character separates
+// output: number of values read (at most 'count'), 0 if a value is too big
+static uint8_t parseConsoleNumbers(uint8_t *values, uint8_t count)
+{
+	const char *text = &consoleLine[consoleArgument];
+	uint16_t value = 0;
+	uint8_t found = 0;
+	
+	while(*text && (found < count))
+	{
+		if((*text >= '0') && (*text <= '9'))
+		{
+			value = 0;
+			while((*text >= '0') && (*text <= '9'))
+			{
+				value = value * 10 + (*text - '0');
+				if(value > 255)
+				{
+					return 0;
+				}
+				text++;
+			}
+			values[found++] = value;
+		}
+		else
+		{
+			text++;
+		}
+	}
+	return found;
+}
+
+//! Execute a command with an output of one line
+static void executeConsoleCommand(uint8_t command)
+{
+	uint8_t i = 0;
+	
+	switch(command)
+	{
+		// list of commands
+		case CONSOLE_COMMAND_HELP:
+		{
+			for(i = 0; i < sizeof(consoleCommands) / sizeof(consoleCommands[0]); i++)
+			{
+				usart0TransmitText(consoleCommands[i].name);
+				usart0Transmit(' ');
+			}
+			usart0TransmitText(PSTR("\r\n"));
+			break;
+		}
+		
+		// get or set system time
+		case CONSOLE_COMMAND_TIME:
+		{
+			if(consoleLine[consoleArgument])
+			{
+				consoleSetTime();
+				break;
+			}
+			usart0TransmitNumber(systemTime.hour, 2);
+			usart0Transmit(':');
+			usart0TransmitNumber(systemTime.minute, 2);
+			usart0Transmit(':');
+			usart0TransmitNumber(systemTime.second, 2);
+			usart0Transmit(' ');
+			usart0TransmitNumber(systemTime.day, 2);
+			usart0Transmit('.');
+			usart0TransmitNumber(systemTime.month, 2);
+			usart0Transmit('.');
+			usart0TransmitNumber(systemTime.year, 2);
+			usart0Transmit(' ');
+			usart0TransmitNumber(systemTime.weekday, 1);
+			usart0TransmitText(PSTR("\r\n"));
+			break;
+		}
+		
+		// configuration values
+		case CONSOLE_COMMAND_CONFIG:
+		{
+			usart0TransmitText(PSTR("status "));
+			usart0TransmitHex(systemConfig.status);
+			usart0TransmitText(PSTR(" setting "));
+			usart0TransmitHex(systemConfig.displaySetting);
+			usart0TransmitText(PSTR(" bright "));
+			usart0TransmitNumber(systemConfig.manualBrightness, 1);
+			usart0TransmitText(PSTR(" pie "));
+			usart0TransmitNumber(systemConfig.pieShift, 1);
+			usart0TransmitText(PSTR("\r\n"));
+			break;
+		}
+		
+		// statistics of dcf77 frames
+		case CONSOLE_COMMAND_DCF:
+		{
+			usart0TransmitText(PSTR("frames "));
+			usart0TransmitNumber(dcfStatistics.frames, 1);
+			usart0TransmitText(PSTR(" ok "));
+			usart0TransmitNumber(dcfStatistics.accepted, 1);
+			usart0TransmitText(PSTR(" failed"));
+			for(i = 0; i < sizeof(dcfStatistics.rejected); i++)
+			{
+				usart0Transmit(' ');
+				usart0TransmitNumber(dcfStatistics.rejected[i], 1);
+			}
+			usart0TransmitText(PSTR("\r\n"));
+			break;
+		}
+		
+		// automatic time mode: search dcf77 signal, the time is shown meanwhile
+		case CONSOLE_COMMAND_SYNC:
+		{
+			// - xxx0.xxxxb automatic time mode is active
+			systemConfig.status &= ~0x10;
+			startDcf77Signal();
+			saveConfig();
+			usart0TransmitText(PSTR("ok\r\n"));
+			break;
+		}
+		
+		// automatic or manual display brightness
+		case CONSOLE_COMMAND_BRIGHT:
+		{
+			consoleSetBrightness();
+			break;
+		}
+		
+#ifdef TELEMETRY_ENABLED
+		// start or stop telemetry stream
+		case CONSOLE_COMMAND_TELEMETRY:
+		{
+			if(!strcmp_P(&consoleLine[consoleArgument], PSTR("on")))
+			{
+				setTelemetry(1);
+			}
+			else if(!strcmp_P(&consoleLine[consoleArgument], PSTR("off")))
+			{
+				setTelemetry(0);
+			}
+			else
+			{
+				usart0TransmitText(PSTR("error\r\n"));
+				break;
+			}
+			usart0TransmitText(PSTR("ok\r\n"));
+			break;
+		}
+#endif
+		
+		// empty line
+		case CONSOLE_COMMAND_NONE:
+		{
+			break;
+		}
+		
+		default:
+		{
+			usart0TransmitText(PSTR("unknown command\r\n"));
+			break;
+		}
+	}
+}
+
+//! Set manual time: "time hh:mm:ss dd.mm.yy weekday"
+static void consoleSetTime(void)
+{
+	uint8_t values[7];
+	
+	// all values in range
+	if((parseConsoleNumbers(values, 7) != 7) ||
+	   (values[0] > 23) || (values[1] > 59) || (values[2] > 59) ||
+	   (values[3] < 1) || (values[3] > 31) || (values[4] < 1) || (values[4] > 12) ||
+	   (values[5] > 99) || (values[6] < 1) || (values[6] > 7))
+	{
+		usart0TransmitText(PSTR("error\r\n"));
+		return;
+	}
+	
+	// the menu uses the manual time as well
+	if(systemConfig.status & 0x08)
+	{
+		usart0TransmitText(PSTR("busy\r\n"));
+		return;
+	}
+	
+	setTime.hour	= values[0];
+	setTime.minute	= values[1];
+	setTime.second	= values[2];
+	setTime.day		= values[3];
+	setTime.month	= values[4];
+	setTime.year	= values[5];
+	setTime.weekday	= values[6];
+	storeManualTime();
+	saveConfig();
+	
+	// actualize matrix information
+	displayMatrixInformation();
+	usart0TransmitText(PSTR("ok\r\n"));
+}
+
+//! Set display brightness: "bright auto" or "bright 0 ... 255"
+static void consoleSetBrightness(void)
+{
+	uint8_t value = 0;
+	
+	// (bit 6): automatic display brightness regulation is active
+	if(!strcmp_P(&consoleLine[consoleArgument], PSTR("auto")))
+	{
+		systemConfig.displaySetting |= 0x40;
+	}
+	else if(parseConsoleNumbers(&value, 1) == 1)
+	{
+		systemConfig.displaySetting &= ~0x40;
+		systemConfig.manualBrightness = value;
+	}
+	else
+	{
+		usart0TransmitText(PSTR("error\r\n"));
+		return;
+	}
+	
+	// new brightness with next adc sample
+	saveConfig();
+	usart0TransmitText(PSTR("ok\r\n"));
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,43 @@
+/*******************************************************************************
+*
+*	Author:			Georg Bauer
+*	Date:			18.10.2026
+*
+*	Project-Title:	ClockWise
+*	Description:	Command console on usart 0
+*
+*	File-Title:		Console - Header File
+*
+*******************************************************************************
+*/
+
+//! Libraries
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include <stdint.h>
+
+//! command of console (see consoleCommands in console.c)
+struct consoleCommand
+{
+	char name[8];		// command word
+	uint8_t command;	// command number (see CONSOLE_COMMAND_*)
+};
+
+//! Functional prototypes
+void initConsole(void);
+void requestConsoleCommand(uint8_t command);
+uint8_t threadConsole(void);
+
+//! Commands
+#define CONSOLE_COMMAND_NONE		0	// no command
+#define CONSOLE_COMMAND_HELP		1	// list of commands
+#define CONSOLE_COMMAND_TIME		2	// get or set (manual) system time
+#define CONSOLE_COMMAND_CONFIG		3	// configuration values
+#define CONSOLE_COMMAND_DCF			4	// statistics of dcf77 frames
+#define CONSOLE_COMMAND_SYNC		5	// automatic time mode, search dcf77 signal
+#define CONSOLE_COMMAND_BRIGHT		6	// automatic or manual display brightness
+#define CONSOLE_COMMAND_LOG			7	// dump of event log
+#define CONSOLE_COMMAND_PROFILE		8	// dump of task profiles
+#define CONSOLE_COMMAND_TELEMETRY	9	// start or stop telemetry stream
+#define CONSOLE_COMMAND_BOOT		10	// start serial bootloader
+#define CONSOLE_COMMAND_UNKNOWN		0xFF	// line is not a command
\ No newline at end of file
@@ -44,16 +44,32 @@
 #include "dcf77.h"
 #include "system.h"
 #include "gpios.h"
+#include "events.h"
+#include "rtc.h"
+#include "log.h"
+#include "telemetry.h"
 
 //! Own global variables
 // Flag for receiving dcf77 signal
 volatile uint8_t dcfActive = 0;
 // Array for saving receiving dcf77 signal
 volatile uint8_t dcfArray [60];
+// statistics of decoded frames (main loop only)
+struct dcfStatistics dcfStatistics;
+#ifdef TELEMETRY_ENABLED
+// system ticks at start of pulse (timer 0 is restarted) and width of pulse
+// in steps of timer 0 (64us), captured at the end of pulse (0: no edge)
+volatile uint16_t dcfPulseStart;
+volatile uint16_t dcfPulseWidth;
+#endif
 
 //! Extern globals variables
 extern volatile struct time systemTime;
 extern volatile struct systemParameter systemConfig;
+extern volatile uint16_t systemTicks;
+
+//! Functional prototypes
+static void rejectDcf77Frame(uint8_t reason);
 
 //! Initialize dcf77
 void initDcf77(void)
@@ -119,7 +135,7 @@ uint8_t plausibilityCheck (	uint8_t hourNew, uint8_t minuteNew, uint8_t hourOld,
 	return 0;
 }
 
-//! Decode dcf77 received bits
+//! Decode dcf77 received bits, called by dcf frame event in main loop
 void decodeDcf77(void)
 {
 	// static variables for time values for next decode session
@@ -135,6 +151,11 @@ void decodeDcf77(void)
 	uint8_t weekday = 0;
 	uint8_t parity = 0;
 	
+	if (dcfStatistics.frames < 0xFFFF)
+	{
+		dcfStatistics.frames++;
+	}
+	
 	// decode minute information
 	// minutes
 	// 21 22 23 24 25 26 27 28
@@ -184,6 +205,7 @@ void decodeDcf77(void)
 		}
 		else
 		{
+			rejectDcf77Frame(LOG_DCF_PARITY_MINUTE);
 			return;
 		}
 	}
@@ -195,6 +217,7 @@ void decodeDcf77(void)
 		}
 		else
 		{
+			rejectDcf77Frame(LOG_DCF_PARITY_MINUTE);
 			return;
 		}
 	}	
@@ -243,6 +266,7 @@ void decodeDcf77(void)
 		}
 		else
 		{
+			rejectDcf77Frame(LOG_DCF_PARITY_HOUR);
 			return;
 		}
 	}
@@ -255,6 +279,7 @@ void decodeDcf77(void)
 		}
 		else
 		{
+			rejectDcf77Frame(LOG_DCF_PARITY_HOUR);
 			return;
 		}
 	}
@@ -399,6 +424,7 @@ void decodeDcf77(void)
 		}
 		else
 		{
+			rejectDcf77Frame(LOG_DCF_PARITY_DATE);
 			return;
 		}
 	}
@@ -410,6 +436,7 @@ void decodeDcf77(void)
 		}
 		else
 		{
+			rejectDcf77Frame(LOG_DCF_PARITY_DATE);
 			return;
 		}
 	}
@@ -418,15 +445,37 @@ void decodeDcf77(void)
 	if (plausibilityCheck (hour, minute, hourOld, minuteOld))
 	{
 		// if plausibility check okey, set global time values
-		systemTime.hour = hour;	
-		systemTime.minute = minute;
-		systemTime.second = 0;
-		systemTime.day = day;
-		systemTime.month = month;
-		systemTime.year = year;
-		systemTime.weekday = weekday;
+		// (time management isr is running)
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			systemTime.hour = hour;	
+			systemTime.minute = minute;
+			systemTime.second = 0;
+			systemTime.day = day;
+			systemTime.month = month;
+			systemTime.year = year;
+			systemTime.weekday = weekday;
+		}
 			
 		stopDcf77Signal();
+		
+		// write accepted time to rtc (rate limited)
+		requestRtcWriteBack();
+		logEvent(LOG_EVENT_DCF_SYNC, 0);
+		if (dcfStatistics.accepted < 0xFFFF)
+		{
+			dcfStatistics.accepted++;
+		}
+#ifdef TELEMETRY_ENABLED
+		{
+			uint8_t data[7] = {0, hour, minute, day, month, year, weekday};
+			sendTelemetry(TELEMETRY_DCF_DECODE, data, sizeof(data));
+		}
+#endif
+	}
+	else
+	{
+		rejectDcf77Frame(LOG_DCF_PLAUSIBILITY);
 	}
 	
 	// save actual time values for next decode session
@@ -434,6 +483,19 @@ void decodeDcf77(void)
 	hourOld = hour;
 }
 
+//! Count and log a rejected frame (reason see LOG_DCF_*)
+static void rejectDcf77Frame(uint8_t reason)
+{
+	if (dcfStatistics.rejected[reason - 1] < 255)
+	{
+		dcfStatistics.rejected[reason - 1]++;
+	}
+	logEvent(LOG_EVENT_DCF_FAIL, reason);
+#ifdef TELEMETRY_ENABLED
+	sendTelemetry(TELEMETRY_DCF_DECODE, &reason, 1);
+#endif
+}
+
 //! activate dcf77 signal
 void startDcf77Signal(void)
 {
@@ -443,12 +505,16 @@ void startDcf77Signal(void)
 	systemConfig.status |= 0x02;
 	
 	//! external interrupt for signal of dcf 77 receiver
-	// enabled external pin change interrupts PCINT23:16
-	PCICR |= 1 << PCIE2;
-	// activate PC2 (PCINT22) as external interrupt
-	PCMSK2 |= 1 << PCINT22;
-	// delete flag for interrupts PCINT23:16
-	PCIFR |= 1 << PCIF2;
+	// PCMSK2 is changed by the dcf77 isr's as well
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		// enabled external pin change interrupts PCINT23:16
+		PCICR |= 1 << PCIE2;
+		// activate PC2 (PCINT22) as external interrupt
+		PCMSK2 |= 1 << PCINT22;
+		// delete flag for interrupts PCINT23:16
+		PCIFR |= 1 << PCIF2;
+	}
 	
 	// enable when pc7 low
 	// switch PC7 low
@@ -468,12 +534,16 @@ void stopDcf77Signal(void)
 	systemConfig.status &= ~0x02;
 
 	//! external interrupt for signal of dcf 77 receiver
-	// disabled external pin change interrupts PCINT23:16
-	PCICR &= ~(1 << PCIE2);
-	// inactivate PC2 (PCINT22) as external interrupt
-	PCMSK2 &= ~(1 << PCINT22);
-	// delete flag for interrupts PCINT23:16
-	PCIFR |= 1 << PCIF2;
+	// PCMSK2 is changed by the dcf77 isr's as well
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		// disabled external pin change interrupts PCINT23:16
+		PCICR &= ~(1 << PCIE2);
+		// inactivate PC2 (PCINT22) as external interrupt
+		PCMSK2 &= ~(1 << PCINT22);
+		// delete flag for interrupts PCINT23:16
+		PCIFR |= 1 << PCIF2;
+	}
 	
 	// test
 	switchOffStatusRed();
@@ -486,6 +556,29 @@ void stopDcf77Signal(void)
 //! Interrupt Service Routine for when DCF77 signal changes
 ISR(PCINT2_vect)			// start signal 0,1s or 0,2s 
 {
+#ifdef TELEMETRY_ENABLED
+	// system ticks and timer 0 (a pending overflow of timer 0 is not
+	// counted in system ticks yet)
+	uint8_t timer = TCNT0;
+	uint16_t ticks = systemTicks;
+	if ((TIFR0 & (1 << TOV0)) && (timer < 128))
+	{
+		ticks++;
+	}
+	
+	// end of pulse: width since start with 64us, the bit is decided by
+	// timer 0 overflow isr
+	if (dcfActive)
+	{
+		dcfPulseWidth = ((ticks - dcfPulseStart) << 8) | timer;
+		PCMSK2 &= ~(1 << PCINT22);
+		return;
+	}
+	
+	// start of pulse: system ticks and timer 0 since start of last pulse
+	postTelemetry(TELEMETRY_DCF_EDGE, ticks, ticks >> 8, timer);
+#endif
+	
 	// reset of timer 0
 	TCNT0 = 0;						
 	// set dcf77 receive flag 
@@ -494,8 +587,16 @@ ISR(PCINT2_vect)			// start signal 0,1s or 0,2s
 	// set status led yellow
 	switchOnStatusYellow();
 	
+#ifdef TELEMETRY_ENABLED
+	// overflows of timer 0 since restart are counted from here (an overflow
+	// before the restart is still pending), the interrupt stays active for
+	// the end of pulse
+	dcfPulseStart = systemTicks + ((TIFR0 & (1 << TOV0)) ? 1 : 0);
+	dcfPulseWidth = 0;
+#else
 	// deactivate external interrupt, if signal is complete, interrupt will be activated
 	PCMSK2 &= ~(1 << PCINT22);
+#endif
 }
 
 //! Interrupt Service Routine for when Timer/Counter 0 has an overflow
@@ -508,6 +609,9 @@ ISR(TIMER0_OVF_vect)
 	static uint8_t timeCount = 0;
 	static uint8_t arrayCount = 0;
 	
+	// count system ticks (time base of protothreads)
+	systemTicks++;
+	
 	// signal is active
 	if (dcfActive)
 	{
@@ -516,11 +620,14 @@ ISR(TIMER0_OVF_vect)
 		// reset all counters and activate the external interrupt
 		if (breakCount > 91)
 		{
+#ifdef TELEMETRY_ENABLED
+			postTelemetry(TELEMETRY_DCF_MINUTE, arrayCount, systemTicks, systemTicks >> 8);
+#endif
 			// if 58th characters received (array counter is out of range) 
-			// run the execution function 
+			// tell main loop to run the execution function 
 			if (arrayCount >= 58)
 			{
-				decodeDcf77();
+				postEvent(EVENT_DCF_FRAME, arrayCount);
 			}
 
 			// reset break counter
@@ -553,6 +660,16 @@ ISR(TIMER0_OVF_vect)
 			{
 				dcfArray[arrayCount] = 1;
 			}
+#ifdef TELEMETRY_ENABLED
+			// width with 64us of pulse end, else with system ticks
+			if (!dcfPulseWidth)
+			{
+				dcfPulseWidth = (uint16_t)timeCount << 8;
+			}
+			// width (15 bits) and value (bit 15)
+			dcfPulseWidth = (dcfPulseWidth & 0x7FFF) | ((uint16_t)dcfArray[arrayCount] << 15);
+			postTelemetry(TELEMETRY_DCF_BIT, arrayCount, dcfPulseWidth, dcfPulseWidth >> 8);
+#endif
 					
 			// increment signal char counter
 			arrayCount++;
@@ -14,8 +14,17 @@
 //! Libraries
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <util/atomic.h>
 #include <stdint.h>
 
+//! Statistics of decoded frames (counters are saturated)
+struct dcfStatistics
+{
+	uint16_t frames;		// received frames with 58 bits
+	uint16_t accepted;		// frames with accepted time
+	uint8_t rejected[4];	// rejected frames per reason (LOG_DCF_* - 1)
+};
+
 //! Functional prototypes
 void initDcf77(void);
 uint8_t plausibilityCheck(uint8_t hourNew, uint8_t minuteNew, uint8_t hourOld, uint8_t minuteOld);
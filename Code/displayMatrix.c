@@ -17,12 +17,17 @@
 #include "gpios.h"
 #include "ledMatrix.h"
 
+//! Own global variables
+// selected view of standard mode (text time, time or date in 00 lbr 00 mode)
+uint8_t displayView = DISPLAY_STATE_TIME_TEXT;
+
 //! Extern global variables
 extern volatile struct systemParameter systemConfig;
 
 //! makes menu management
-// input: is function called by a activation by switch than switchActiviation = 1, else switchActiviation = 0
-void displayMatrixInformation(uint8_t switchActiviation)
+// the searching sequence is displayed by its thread, so a call by a switch
+// needs no special case anymore
+void displayMatrixInformation(void)
 {
 
 	// if menu mode
@@ -37,17 +42,44 @@ void displayMatrixInformation(uint8_t switchActiviation)
 		// display time and dot action
 		if(systemConfig.status & 0x01)
 		{
-			// actualize 'actualMatrix' Register with system time
-			actualizeMatrixWithSystemTime();
-		}
-		// if no time signal is available
-		else
-		{
-			if(!switchActiviation)
+			// boot metric: time to first valid frame
+			markFirstValidFrame();
+			
+			// actualize 'actualMatrix' Register with selected view
+			switch(displayView)
 			{
-				// actualize 'actualMatrix' Register with searching sequence
-				actualizeMatrixWithSearchingSequence();
+				case DISPLAY_STATE_TIME_NUMBER:
+				{
+					actualizeMatrixWithTimeNumber();
+					break;
+				}
+				case DISPLAY_STATE_DATE_NUMBER:
+				{
+					actualizeMatrixWithDateNumber();
+					break;
+				}
+				default:
+				{
+					actualizeMatrixWithSystemTime();
+					break;
+				}
 			}
 		}
+		// if no time signal is available, the searching sequence is
+		// displayed by its thread (see threadSearchingSequence())
+	}
+}
+
+//! changes view of standard mode: time in text mode, time and date in 00 lbr 00 mode
+// input: next view if up = 1, else previous view
+void changeDisplayView(uint8_t up)
+{
+	if(up)
+	{
+		displayView = (displayView >= DISPLAY_STATE_DATE_NUMBER) ? DISPLAY_STATE_TIME_TEXT : displayView + 1;
+	}
+	else
+	{
+		displayView = (displayView <= DISPLAY_STATE_TIME_TEXT) ? DISPLAY_STATE_DATE_NUMBER : displayView - 1;
 	}
 }
\ No newline at end of file
@@ -16,4 +16,5 @@
 #include <stdint.h>
 
 //! Functional prototypes
-void displayMatrixInformation(uint8_t switchActiviation);
\ No newline at end of file
+void displayMatrixInformation(void);
+void changeDisplayView(uint8_t up);
\ No newline at end of file
@@ -0,0 +1,98 @@
+/*******************************************************************************
+*
+*	Author:			Georg Bauer
+*	Date:			18.10.2026
+*
+*	Project-Title:	ClockWise
+*	Description:	Event queue from interrupt service routines to main loop
+*
+*	File-Title:		Events
+*
+*******************************************************************************
+*
+* Single-producer/single-consumer ring buffer:
+* - producer are the interrupt service routines (they don't interrupt each
+*	other, so all of them together are one producer), they call postEvent()
+* - consumer is the main loop, it calls getEvent()
+*
+* Read and write index are free running 8 bit counters, only the producer
+* changes the write index and only the consumer changes the read index. Both
+* are written with one single instruction, so no interrupt masking is needed.
+* The queue size has to be a power of two (see settings.h).
+*
+*******************************************************************************
+*/
+
+//! Libraries
+#include "events.h"
+#include "settings.h"
+
+//! Own global variables
+volatile struct event eventQueue[EVENT_QUEUE_SIZE];
+volatile uint8_t eventHead;		// write index, only changed by producer (isr)
+volatile uint8_t eventTail;		// read index, only changed by consumer (main loop)
+volatile uint8_t eventDropped;	// counts events lost on a full queue
+
+//! Initialize event queue
+void initEvents(void)
+{
+	// empty queue
+	eventHead = 0;
+	eventTail = 0;
+	eventDropped = 0;
+}
+
+//! Post an event to the queue, only called from interrupt service routines
+// return value is '1', means event is queued
+// return value is '0', means queue is full and event is dropped
+uint8_t postEvent(uint8_t type, uint8_t data)
+{
+	uint8_t head = eventHead;
+
+	// queue full?
+	if ((uint8_t)(head - eventTail) >= EVENT_QUEUE_SIZE)
+	{
+		// count dropped event (saturated)
+		if (eventDropped < 255)
+		{
+			eventDropped++;
+		}
+		return 0;
+	}
+
+	// write event first ...
+	eventQueue[head & (EVENT_QUEUE_SIZE - 1)].type = type;
+	eventQueue[head & (EVENT_QUEUE_SIZE - 1)].data = data;
+	// ... and publish it afterwards
+	eventHead = head + 1;
+
+	return 1;
+}
+
+//! Get next event of the queue, only called from main loop
+// return value is '1', means 'nextEvent' is filled
+// return value is '0', means queue is empty
+uint8_t getEvent(struct event *nextEvent)
+{
+	uint8_t tail = eventTail;
+
+	// queue empty?
+	if (tail == eventHead)
+	{
+		return 0;
+	}
+
+	// read event first ...
+	nextEvent->type = eventQueue[tail & (EVENT_QUEUE_SIZE - 1)].type;
+	nextEvent->data = eventQueue[tail & (EVENT_QUEUE_SIZE - 1)].data;
+	// ... and release the slot afterwards
+	eventTail = tail + 1;
+
+	return 1;
+}
+
+//! Get number of dropped events
+uint8_t getDroppedEvents(void)
+{
+	return eventDropped;
+}
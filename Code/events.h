@@ -0,0 +1,38 @@
+/*******************************************************************************
+*
+*	Author:			Georg Bauer
+*	Date:			18.10.2026
+*
+*	Project-Title:	ClockWise
+*	Description:	Event queue from interrupt service routines to main loop
+*
+*	File-Title:		Events - Header File
+*
+*******************************************************************************
+*/
+
+//! Libraries
+#include <stdint.h>
+
+//! Event Structure
+struct event
+{
+	uint8_t type;	// event type, see defines below
+	uint8_t data;	// event data, depends on event type
+};
+
+//! Functional prototypes
+void initEvents(void);
+uint8_t postEvent(uint8_t type, uint8_t data);
+uint8_t getEvent(struct event *nextEvent);
+uint8_t getDroppedEvents(void);
+
+//! Event Types
+#define EVENT_NONE					0	// no event
+#define EVENT_TICK					1	// second tick of time management, data: not used
+#define EVENT_BUTTON				2	// debounced switch pressed or repeated, data: state of all switches
+#define EVENT_DCF_FRAME				3	// dcf77 frame complete, data: number of received bits
+#define EVENT_ADC_SAMPLE			4	// filtered adc value available, data: adc channel
+#define EVENT_BUTTON_RELEASE		5	// debounced switch released, data: released switches
+#define EVENT_BUTTON_LONG			6	// switches hold for a long time, data: state of all switches
+#define EVENT_RTC					7	// rtc transaction finished, data: operation, register and error flag (see rtc.h)
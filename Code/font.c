@@ -0,0 +1,188 @@
+/*******************************************************************************
+*
+*	Author:			Georg Bauer
+*	Date:			18.10.2026
+*
+*	Project-Title:	ClockWise
+*	Description:	3x5 font for text and numbers on the led matrix
+*
+*	File-Title:		Font
+*
+*******************************************************************************
+*
+* Every character of the font (ASCII 0x20 space to 0x5A Z and 0x65 e, a
+* narrow E of 2 columns for labels like TIMe) has 5 rows with up to 3 columns
+* and is saved in 3 bytes:
+*	byte 0: row 0 (bit 7 to 4), row 1 (bit 3 to 0)
+*	byte 1: row 2 (bit 7 to 4), row 3 (bit 3 to 0)
+*	byte 2: row 4 (bit 7 to 4), width in columns (bit 3 to 0)
+* In every row nibble the highest bit is the left column. A character with
+* width 0 is not available.
+*
+* Characters are or'ed into 'actualMatrix' at any row and column, the column
+* is shifted across the high and low byte of the rows. Columns right of the
+* matrix (12 to 15) are cut off. One empty column is between two characters.
+*
+*******************************************************************************
+*/
+
+//! Libraries
+#include "font.h"
+#include "ledMatrix.h"
+
+//! Own global variables
+const uint8_t font3x5[FONT_CHARACTERS][3] PROGMEM =
+{
+	{0x00, 0x00, 0x02},	// ' '
+	{0x00, 0x00, 0x00},	// not available
+	{0x00, 0x00, 0x00},	// not available
+	{0x00, 0x00, 0x00},	// not available
+	{0x00, 0x00, 0x00},	// not available
+	{0x00, 0x00, 0x00},	// not available
+	{0x00, 0x00, 0x00},	// not available
+	{0x00, 0x00, 0x00},	// not available
+	{0x00, 0x00, 0x00},	// not available
+	{0x00, 0x00, 0x00},	// not available
+	{0x00, 0x00, 0x00},	// not available
+	{0x00, 0x00, 0x00},	// not available
+	{0x00, 0x00, 0x00},	// not available
+	{0x00, 0xE0, 0x03},	// '-'
+	{0x00, 0x00, 0x81},	// '.'
+	{0x00, 0x00, 0x00},	// not available
+	{0xEA, 0xAA, 0xE3},	// '0'
+	{0x4C, 0x44, 0xE3},	// '1'
+	{0xE2, 0xE8, 0xE3},	// '2'
+	{0xE2, 0xE2, 0xE3},	// '3'
+	{0xAA, 0xE2, 0x23},	// '4'
+	{0xE8, 0xE2, 0xE3},	// '5'
+	{0xE8, 0xEA, 0xE3},	// '6'
+	{0xE2, 0x22, 0x23},	// '7'
+	{0xEA, 0xEA, 0xE3},	// '8'
+	{0xEA, 0xE2, 0xE3},	// '9'
+	{0x08, 0x08, 0x01},	// ':'
+	{0x00, 0x00, 0x00},	// not available
+	{0x00, 0x00, 0x00},	// not available
+	{0x00, 0x00, 0x00},	// not available
+	{0x00, 0x00, 0x00},	// not available
+	{0xE2, 0x60, 0x43},	// '?'
+	{0x00, 0x00, 0x00},	// not available
+	{0x4A, 0xEA, 0xA3},	// 'A'
+	{0xCA, 0xCA, 0xC3},	// 'B'
+	{0x68, 0x88, 0x63},	// 'C'
+	{0xCA, 0xAA, 0xC3},	// 'D'
+	{0xE8, 0xC8, 0xE3},	// 'E'
+	{0xE8, 0xC8, 0x83},	// 'F'
+	{0xE8, 0xAA, 0xE3},	// 'G'
+	{0xAA, 0xEA, 0xA3},	// 'H'
+	{0x88, 0x88, 0x81},	// 'I'
+	{0x22, 0x2A, 0x43},	// 'J'
+	{0xAA, 0xCA, 0xA3},	// 'K'
+	{0x88, 0x88, 0xE3},	// 'L'
+	{0xAE, 0xAA, 0xA3},	// 'M'
+	{0xCA, 0xAA, 0xA3},	// 'N'
+	{0xEA, 0xAA, 0xE3},	// 'O'
+	{0xCA, 0xC8, 0x83},	// 'P'
+	{0x4A, 0xAC, 0x63},	// 'Q'
+	{0xCA, 0xCA, 0xA3},	// 'R'
+	{0xE8, 0xE2, 0xE3},	// 'S'
+	{0xE4, 0x44, 0x43},	// 'T'
+	{0xAA, 0xAA, 0xE3},	// 'U'
+	{0xAA, 0xAA, 0x43},	// 'V'
+	{0xAA, 0xAE, 0xA3},	// 'W'
+	{0xAA, 0x4A, 0xA3},	// 'X'
+	{0xAA, 0x44, 0x43},	// 'Y'
+	{0xE2, 0x48, 0xE3},	// 'Z'
+	{0x00, 0x00, 0x00},	// not available
+	{0x00, 0x00, 0x00},	// not available
+	{0x00, 0x00, 0x00},	// not available
+	{0x00, 0x00, 0x00},	// not available
+	{0x00, 0x00, 0x00},	// not available
+	{0x00, 0x00, 0x00},	// not available
+	{0x00, 0x00, 0x00},	// not available
+	{0x00, 0x00, 0x00},	// not available
+	{0x00, 0x00, 0x00},	// not available
+	{0x00, 0x00, 0x00},	// not available
+	{0xC8, 0xC8, 0xC2}	// 'e' narrow E (2 columns)
+};
+
+//! Extern global variables
+extern volatile struct row actualMatrix[12];
+
+//! draw a character into the matrix (or'ed)
+// input: top row, left column (0 to 11) and character
+// return: width of character in columns
+uint8_t drawMatrixChar(uint8_t row, uint8_t column, char character)
+{
+	uint8_t i = 0;
+	uint8_t index = 0;
+	uint8_t bits = 0;
+	uint16_t line = 0;
+	
+	// not available characters
+	if((character < FONT_FIRST) || (character >= FONT_FIRST + FONT_CHARACTERS) || (column > 11))
+	{
+		return 0;
+	}
+	index = character - FONT_FIRST;
+	
+	for(i = 0; (i < 5) && (row + i < 12); i++)
+	{
+		// get row nibble of character (even rows in high nibble)
+		bits = pgm_read_byte(&font3x5[index][i >> 1]);
+		if(!(i & 0x01))
+		{
+			bits >>= 4;
+		}
+		
+		// shift to column: bit 15 of line is column 0
+		line = ((uint16_t)(bits & 0x0F) << 12) >> column;
+		actualMatrix[row + i].high	|= line >> 8;
+		actualMatrix[row + i].low	|= line & 0xF0;
+	}
+	
+	return pgm_read_byte(&font3x5[index][2]) & 0x0F;
+}
+
+//! draw a text from flash into the matrix (or'ed)
+// input: top row, left column and text (PSTR)
+// return: next free column
+uint8_t drawMatrixText(uint8_t row, uint8_t column, const char *text)
+{
+	char character = 0;
+	
+	while((character = pgm_read_byte(text++)))
+	{
+		column += drawMatrixChar(row, column, character) + 1;
+	}
+	
+	return column;
+}
+
+//! draw a decimal number into the matrix (or'ed)
+// input: top row, left column, value and number of digits (leading zeros)
+// return: next free column
+uint8_t drawMatrixNumber(uint8_t row, uint8_t column, uint16_t value, uint8_t digits)
+{
+	char number[5];
+	uint8_t i = 0;
+	
+	// limitation
+	if(digits > 5)
+	{
+		digits = 5;
+	}
+	
+	// digits from right to left
+	for(i = digits; i > 0; i--)
+	{
+		number[i - 1] = '0' + (value % 10);
+		value /= 10;
+	}
+	
+	for(i = 0; i < digits; i++)
+	{
+		column += drawMatrixChar(row, column, number[i]) + 1;
+	}
+	
+	return column;
+}
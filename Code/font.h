@@ -0,0 +1,26 @@
+/*******************************************************************************
+*
+*	Author:			Georg Bauer
+*	Date:			18.10.2026
+*
+*	Project-Title:	ClockWise
+*	Description:	3x5 font for text and numbers on the led matrix
+*
+*	File-Title:		Font - Header File
+*
+*******************************************************************************
+*/
+
+//! Libraries
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include <stdint.h>
+
+//! Functional prototypes
+uint8_t drawMatrixChar(uint8_t row, uint8_t column, char character);
+uint8_t drawMatrixText(uint8_t row, uint8_t column, const char *text);
+uint8_t drawMatrixNumber(uint8_t row, uint8_t column, uint16_t value, uint8_t digits);
+
+//! Characters of font
+#define FONT_FIRST					0x20	// first character (space)
+#define FONT_CHARACTERS				70		// space to Z and narrow e
\ No newline at end of file
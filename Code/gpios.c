@@ -13,10 +13,11 @@
 * Pin Declaration:
 *	Pin						| Description
 *	------------------------|-------------------------------------------------
-*	PA2 (Pin 38) as input	| Switch 1 - external interrupt PCINT2
-*	PA3 (Pin 37) as input	| Switch 2 - external interrupt PCINT3
-*	PA4 (Pin 36) as input	| Switch 3 - external interrupt PCINT4
-*	PA5 (Pin 35) as input	| Switch 4 - external interrupt PCINT5
+*	PA2 (Pin 38) as input	| Switch 1 - sampled by button driver (buttons.c)
+*	PA3 (Pin 37) as input	| Switch 2 - sampled by button driver (buttons.c)
+*	PA4 (Pin 36) as input	| Switch 3 - sampled by button driver (buttons.c)
+*	PA5 (Pin 35) as input	| Switch 4 - sampled by button driver (buttons.c)
+*	PA6 (Pin 34) as input	| SQW/OUT of rtc - timebase of seconds (timeMgnt.c)
 *	------------------------|-------------------------------------------------
 *	PB0 (Pin 1) as output	| Dot 1 LED
 *	PB1 (Pin 2) as output	| Dot 2 LED
@@ -35,7 +36,6 @@
 //! Libraries
 #include "gpios.h"
 #include "system.h"
-#include "menu.h"
 
 /*
 // Own global variables
@@ -66,43 +66,7 @@ void initGpios(void)
 	DDRA &= ~((1 << PA5) | (1 << PA4) | (1 << PA3) | (1 << PA2));
 	// disable pull-up resistor on input switches
 	PORTA &= ~((1 << PA5) | (1 << PA4) | (1 << PA3) | (1 << PA2));
-
-	//! external interrupt for switch 1, 2, 3 and 4
-	// enabled external pin change interrupts PCINT0:7
-	PCICR |= 1 << PCIE0;
-	// activate PA2 (PCINT2), PA3 (PCINT3), PA4 (PCINT4), PA5 (PCINT5) as external interrupt
-	PCMSK0 |= (1 << PCINT2) | (1 << PCINT3) | (1 << PCINT4) | (1 << PCINT5);
-	// delete flag for interrupts PCINT0:7
-	PCIFR |= 1 << PCIF0;
-}
-
-//! Interrupt Service Routine for switch 1, 2, 3 and 4
-// is called when a switch is pressed in and pressed out
-ISR(PCINT0_vect)
-{
-	// actual values for switches
-	uint8_t switches;
-
-	// get value of switch 1, 2, 3 and 4 - masking with 0011.1100b and shift to right
-	// alternative text: (PINA & ((1<<PINA2) | (1<<PINA3) | (1<<PINA4) | (1<<PINA5)) >> 2; 
-	switches = (PINA & 0x3C) >> 2;
-
-	// any thing else is pressed in the menu mode
-	if(systemConfig.displayStatus >= DISPLAY_STATE_MENU_WAIT)
-	{
-		// call menu management function
-		menuMgnt(switches);
-	}
-
-	// cancel and ok is pressed at the same time in standard mode
-	if((switches & 0x08) && (switches & 0x01) && (systemConfig.displayStatus <= DISPLAY_STATE_MENU_WAIT))
-	{
-		// set new display status: show version
-		systemConfig.displayStatus = DISPLAY_STATE_MENU_WAIT;
-	}
-
-	// delete flag for interrupts PCINT0:7
-	PCIFR |= 1 << PCIF0;
+	// switches are sampled and debounced by the button driver (buttons.c)
 }
 
 
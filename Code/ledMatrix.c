@@ -50,12 +50,124 @@
 #include "gpios.h"
 #include "settings.h"
 #include "displayMatrix.h"
+#include "taskMgnt.h"
+#include "events.h"
+#include "profiler.h"
+#include "protothread.h"
+#include "brightness.h"
+#include "font.h"
 #include <util/delay.h>
+#include <avr/pgmspace.h>
 
 //! Own global variables
 volatile struct row actualMatrix[12];
 volatile uint8_t actualRow;
 volatile uint8_t acutalDot;
+// only every second led is lit (low supply voltage)
+volatile uint8_t matrixLedLimit;
+// frames without output after every frame (deep dim night mode) and rows
+// left of the actual skipped frames
+volatile uint8_t matrixFrameSkip;
+volatile uint8_t matrixSkipRows;
+// pwm value of each row (current limiter)
+volatile uint8_t rowDuty[12];
+// estimated average current of matrix in mA
+uint16_t matrixCurrent;
+// toggle flag for blinking sequence in menu mode
+uint8_t toggleFlag = 1;
+
+//! Icons of menu screens (row 6 to 11, see MENU_ICON_* in ledMatrix.h)
+const struct row menuIcons[][6] PROGMEM =
+{
+	// empty
+	{{0x00, 0x00}, {0x00, 0x00}, {0x00, 0x00}, {0x00, 0x00}, {0x00, 0x00}, {0x00, 0x00}},
+	// X ? (cancel and ok)
+	{{0x00, 0x00}, {0x88, 0x10}, {0x50, 0x10}, {0x21, 0x20}, {0x50, 0xA0}, {0x88, 0x40}},
+	// ? (ok, cancel is blinking)
+	{{0x00, 0x00}, {0x00, 0x10}, {0x00, 0x10}, {0x01, 0x20}, {0x00, 0xA0}, {0x00, 0x40}},
+	// X (cancel, ok is blinking)
+	{{0x00, 0x00}, {0x88, 0x00}, {0x50, 0x00}, {0x20, 0x00}, {0x50, 0x00}, {0x88, 0x00}},
+	// small x ? (cancel and ok)
+	{{0x00, 0x00}, {0x00, 0x00}, {0x00, 0x00}, {0x50, 0x20}, {0x21, 0x40}, {0x50, 0x80}},
+	// small ? (ok, cancel is blinking)
+	{{0x00, 0x00}, {0x00, 0x00}, {0x00, 0x00}, {0x00, 0x20}, {0x01, 0x40}, {0x00, 0x80}},
+	// small x (cancel, ok is blinking)
+	{{0x00, 0x00}, {0x00, 0x00}, {0x00, 0x00}, {0x50, 0x00}, {0x20, 0x00}, {0x50, 0x00}},
+	// I (straight pie)
+	{{0x02, 0x00}, {0x02, 0x00}, {0x02, 0x00}, {0x02, 0x00}, {0x02, 0x00}, {0x00, 0x00}},
+	// V (shifted pie)
+	{{0x20, 0x20}, {0x10, 0x40}, {0x08, 0x80}, {0x05, 0x00}, {0x02, 0x00}, {0x00, 0x00}}
+};
+
+//! Labels of menu screens (column and text, see MENU_LABEL_* in ledMatrix.h)
+const struct menuLabel menuLabels[] PROGMEM =
+{
+	{0, ""},
+	{0, "VER"},
+	{0, "TIMe"},	// narrow E: 12 columns
+	{0, "AUT"},
+	{0, "MAN"},
+	{0, "SET"},
+	{0, "BRI"},
+	{0, "PIE"},
+	{0, "CHA"},
+	{0, "SER"},
+	{0, "DBG"},
+	{0, "STD"},
+	{0, "HOR"},
+	{0, "SQU"},
+	{0, "NO"},
+	{1, "H"},
+	{1, "M"},
+	{1, "S"},
+	{1, "D"},
+	{1, "M"},
+	{1, "Y"},
+	{1, "W"}
+};
+
+//! Screens of menu states: labels in row 0 and 6, icon in row 6 to 11 (blink:
+// icon while blinking), dynamic content and row of blinking mark
+const struct menuScreen menuScreens[MENU_SCREENS] PROGMEM =
+{
+	{DISPLAY_STATE_MENU_VERSION, MENU_LABEL_VER, MENU_LABEL_EMPTY, MENU_ICON_EMPTY, MENU_ICON_EMPTY, MENU_CONTENT_VERSION, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_TIME_MODE, MENU_LABEL_TIME, MENU_LABEL_EMPTY, MENU_ICON_EMPTY, MENU_ICON_EMPTY, MENU_CONTENT_NONE, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_AUTO_MODE, MENU_LABEL_TIME, MENU_LABEL_AUT, MENU_ICON_EMPTY, MENU_ICON_EMPTY, MENU_CONTENT_NONE, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_AUTO_CANCEL, MENU_LABEL_AUT, MENU_LABEL_EMPTY, MENU_ICON_CANCEL_OK, MENU_ICON_OK, MENU_CONTENT_NONE, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_AUTO_OK, MENU_LABEL_AUT, MENU_LABEL_EMPTY, MENU_ICON_CANCEL_OK, MENU_ICON_CANCEL, MENU_CONTENT_NONE, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_MANUAL_MODE, MENU_LABEL_TIME, MENU_LABEL_MAN, MENU_ICON_EMPTY, MENU_ICON_EMPTY, MENU_CONTENT_NONE, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_MANUAL_CANCEL, MENU_LABEL_MAN, MENU_LABEL_EMPTY, MENU_ICON_CANCEL_OK, MENU_ICON_OK, MENU_CONTENT_NONE, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_MANUAL_OK, MENU_LABEL_MAN, MENU_LABEL_EMPTY, MENU_ICON_CANCEL_OK, MENU_ICON_CANCEL, MENU_CONTENT_NONE, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_SET_HOUR, MENU_LABEL_HOUR, MENU_LABEL_EMPTY, MENU_ICON_SET_CANCEL_OK, MENU_ICON_SET_CANCEL_OK, MENU_CONTENT_SET_TIME, 0},
+	{DISPLAY_STATE_MENU_SET_MINUTE, MENU_LABEL_MINUTE, MENU_LABEL_EMPTY, MENU_ICON_SET_CANCEL_OK, MENU_ICON_SET_CANCEL_OK, MENU_CONTENT_SET_TIME, 1},
+	{DISPLAY_STATE_MENU_SET_SECOND, MENU_LABEL_SECOND, MENU_LABEL_EMPTY, MENU_ICON_SET_CANCEL_OK, MENU_ICON_SET_CANCEL_OK, MENU_CONTENT_SET_TIME, 2},
+	{DISPLAY_STATE_MENU_SET_DAY, MENU_LABEL_DAY, MENU_LABEL_EMPTY, MENU_ICON_SET_CANCEL_OK, MENU_ICON_SET_CANCEL_OK, MENU_CONTENT_SET_TIME, 4},
+	{DISPLAY_STATE_MENU_SET_MONTH, MENU_LABEL_MONTH, MENU_LABEL_EMPTY, MENU_ICON_SET_CANCEL_OK, MENU_ICON_SET_CANCEL_OK, MENU_CONTENT_SET_TIME, 5},
+	{DISPLAY_STATE_MENU_SET_YEAR, MENU_LABEL_YEAR, MENU_LABEL_EMPTY, MENU_ICON_SET_CANCEL_OK, MENU_ICON_SET_CANCEL_OK, MENU_CONTENT_SET_TIME, 6},
+	{DISPLAY_STATE_MENU_SET_WEEKDAY, MENU_LABEL_WEEKDAY, MENU_LABEL_EMPTY, MENU_ICON_SET_CANCEL_OK, MENU_ICON_SET_CANCEL_OK, MENU_CONTENT_SET_TIME, 7},
+	{DISPLAY_STATE_MENU_SET_CANCEL, MENU_LABEL_EMPTY, MENU_LABEL_EMPTY, MENU_ICON_SET_CANCEL_OK, MENU_ICON_SET_OK, MENU_CONTENT_SET_TIME, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_SET_OK, MENU_LABEL_EMPTY, MENU_LABEL_EMPTY, MENU_ICON_SET_CANCEL_OK, MENU_ICON_SET_CANCEL, MENU_CONTENT_SET_TIME, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_SETTINGS, MENU_LABEL_SET, MENU_LABEL_EMPTY, MENU_ICON_EMPTY, MENU_ICON_EMPTY, MENU_CONTENT_NONE, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_BRIGTHNESS, MENU_LABEL_BRI, MENU_LABEL_EMPTY, MENU_ICON_EMPTY, MENU_ICON_EMPTY, MENU_CONTENT_NONE, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_BRIGHT_AUTO, MENU_LABEL_BRI, MENU_LABEL_AUT, MENU_ICON_EMPTY, MENU_ICON_EMPTY, MENU_CONTENT_NONE, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_BRIGHT_MANU, MENU_LABEL_BRI, MENU_LABEL_MAN, MENU_ICON_EMPTY, MENU_ICON_EMPTY, MENU_CONTENT_NONE, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_BRIGHT_VALUE, MENU_LABEL_BRI, MENU_LABEL_EMPTY, MENU_ICON_EMPTY, MENU_ICON_EMPTY, MENU_CONTENT_BRIGHTNESS, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_PIE, MENU_LABEL_PIE, MENU_LABEL_EMPTY, MENU_ICON_EMPTY, MENU_ICON_EMPTY, MENU_CONTENT_NONE, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_PIE_STRAIGHT, MENU_LABEL_PIE, MENU_LABEL_EMPTY, MENU_ICON_STRAIGHT, MENU_ICON_STRAIGHT, MENU_CONTENT_NONE, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_PIE_SHIFT, MENU_LABEL_PIE, MENU_LABEL_EMPTY, MENU_ICON_SHIFT, MENU_ICON_SHIFT, MENU_CONTENT_NONE, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_PIE_MINUTES, MENU_LABEL_PIE, MENU_LABEL_EMPTY, MENU_ICON_EMPTY, MENU_ICON_EMPTY, MENU_CONTENT_PIE_SHIFT, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_CHAR, MENU_LABEL_CHA, MENU_LABEL_EMPTY, MENU_ICON_EMPTY, MENU_ICON_EMPTY, MENU_CONTENT_NONE, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_CHAR_STANDARD, MENU_LABEL_CHA, MENU_LABEL_STD, MENU_ICON_EMPTY, MENU_ICON_EMPTY, MENU_CONTENT_NONE, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_CHAR_BIRTHDAY, MENU_LABEL_CHA, MENU_LABEL_HOR, MENU_ICON_EMPTY, MENU_ICON_EMPTY, MENU_CONTENT_NONE, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_SEARCH_MODE, MENU_LABEL_SER, MENU_LABEL_EMPTY, MENU_ICON_EMPTY, MENU_ICON_EMPTY, MENU_CONTENT_NONE, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_SEARCH_SQUARE, MENU_LABEL_SER, MENU_LABEL_SQU, MENU_ICON_EMPTY, MENU_ICON_EMPTY, MENU_CONTENT_NONE, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_SEARCH_NO, MENU_LABEL_SER, MENU_LABEL_NO, MENU_ICON_EMPTY, MENU_ICON_EMPTY, MENU_CONTENT_NONE, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_DBG, MENU_LABEL_DBG, MENU_LABEL_EMPTY, MENU_ICON_EMPTY, MENU_ICON_EMPTY, MENU_CONTENT_NONE, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_DBG1, MENU_LABEL_DBG, MENU_LABEL_EMPTY, MENU_ICON_EMPTY, MENU_ICON_EMPTY, MENU_CONTENT_DBG1, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_DBG2, MENU_LABEL_DBG, MENU_LABEL_EMPTY, MENU_ICON_EMPTY, MENU_ICON_EMPTY, MENU_CONTENT_DBG2, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_DBG3, MENU_LABEL_DBG, MENU_LABEL_EMPTY, MENU_ICON_EMPTY, MENU_ICON_EMPTY, MENU_CONTENT_DBG3, MENU_MARK_NONE},
+	{DISPLAY_STATE_MENU_DBG4, MENU_LABEL_DBG, MENU_LABEL_EMPTY, MENU_ICON_EMPTY, MENU_ICON_EMPTY, MENU_CONTENT_DBG4, MENU_MARK_NONE}
+};
 
 //! Other global variables
 extern volatile struct systemParameter systemConfig;
@@ -70,16 +182,25 @@ void initMatrix(void)
 	// Initialize uart as spi
 	initUsart();
 	
-	// set standard values
-	actualRow = 12;
+	// set standard values, last row: the first overflow starts with row 0
+	// (a compare match before uses rowDuty[actualRow] as well)
+	actualRow = 11;
 	acutalDot = 0;
+	matrixLedLimit = 0;
+	matrixFrameSkip = 0;
+	matrixSkipRows = 0;
+	matrixCurrent = 0;
+	for(i = 0; i<12; i++)
+	{
+		rowDuty[i] = systemConfig.displayBrightness;
+	}
 	
 	//! timer for regulate information in display rows
 	// 8 bit timer/counter 2
 	// Set OC2A on Compare Match, set OC2A at match
 	// counting from BOTTOM = 0x00 to TOP = 0xFF
 	TCCR2A = (1 << COM2A1) | (1 << COM2A0) | (1 << WGM21) | (1 << WGM20);
-	// clock select: 64 prescale -> 128s (7,8125kHz)
+	// clock select: 64 prescale -> 1,024ms (976Hz), about 81Hz per frame of 12 rows
 	TCCR2B = (1 << CS22);
 	// set compare value for pwm
 	OCR2A = systemConfig.displayBrightness;
@@ -116,6 +237,9 @@ void sendMatrixToShiftRegister(uint8_t row)
 	// variable for masking
 	uint8_t rowMaskHigh = 0;
 	uint8_t rowMaskLow	= 0;
+	// values of row
+	uint8_t rowHigh		= 0;
+	uint8_t rowLow		= 0;
 	
 	// define masks
 	switch(actualRow)
@@ -172,10 +296,30 @@ void sendMatrixToShiftRegister(uint8_t row)
 			break;
 	}
 
+	// reduce lit leds to a checkerboard
+	if (matrixLedLimit)
+	{
+		if (row & 0x01)
+		{
+			rowHigh = actualMatrix[row].high & 0b01010101;
+			rowLow	= actualMatrix[row].low & 0b01010000;
+		}
+		else
+		{
+			rowHigh = actualMatrix[row].high & 0b10101010;
+			rowLow	= actualMatrix[row].low & 0b10100000;
+		}
+	}
+	else
+	{
+		rowHigh = actualMatrix[row].high;
+		rowLow	= actualMatrix[row].low;
+	}
+
 	// send new values
-	usartReceiveTransmit(actualMatrix[row].high);
+	usartReceiveTransmit(rowHigh);
 	//_delay_us(DELAYSPI);
-	usartReceiveTransmit(actualMatrix[row].low | rowMaskHigh); // only an OR operation
+	usartReceiveTransmit(rowLow | rowMaskHigh); // only an OR operation
 	//_delay_us(DELAYSPI);
 	usartReceiveTransmit(rowMaskLow);
 }
@@ -208,9 +352,44 @@ void disableMatrix(void)
 	PORTD |= (1 << PD5);
 }
 
+// stop multiplexing of led matrix (night mode)
+void stopMatrix(void)
+{
+	// stop timer 2 (no clock source)
+	TCCR2B = 0;
+	
+	// switch led matrix off (!LEDEN is hold high)
+	disableMatrix();
+	// switch dot and char leds off
+	switchOffDot1();
+	switchOffDot2();
+	switchOffDot3();
+	switchOffDot4();
+	switchOffChar();
+}
+
+// start multiplexing of led matrix (also in deep dim night mode, the pwm
+// value saves the power: a slower clock would flicker, 256 prescale gives
+// 244Hz, about 20Hz per frame)
+void startMatrix(void)
+{
+	// clock select: 64 prescale -> 1,024ms (976Hz), about 81Hz per frame of 12 rows
+	TCCR2B = (1 << CS22);
+}
+
+// set frames without output after every frame (0: every frame is shown)
+// deep dim night mode: the overflow isr returns at once in skipped frames,
+// 1 gives about 40Hz per frame with half of the isr load
+void setMatrixFrameSkip(uint8_t frames)
+{
+	matrixFrameSkip = frames;
+}
+
 // reset shift register of led matrix
+// skipped if PD1 is used as TXD of usart 0 (every row is shifted completely)
 void resetMatrixShiftRegister(void)
 {
+#ifndef USART0_ENABLED
 	// Reset signal fall down to logical zero
 	PORTD &= ~(1 << PD1);
 		
@@ -219,14 +398,21 @@ void resetMatrixShiftRegister(void)
 		
 	// Reset signal comes back to logical one
 	PORTD |= (1 << PD1);
+#endif
 }
 
 //! Interrupt Service Routine when Timer/Counter 2 has an overflow
-// this routine will called every 128s (7,8125kHz)
-// calculated by: 16MHz /(2^8 [8bit counter] * 8 [main clock divider] * 8 [timer 2 clock divider] = 7,8125kHz
-// calculated by: 16MHz /(2^8 [8bit counter] * 64 [timer 2 clock divider] = 7,8125kHz
+// this routine will called every 1,024ms (976Hz), one row per call
+// calculated by: 16MHz /(2^8 [8bit counter] * 64 [timer 2 clock divider]) = 976Hz
 ISR(TIMER2_OVF_vect)
 {
+	// skipped frame: the matrix stays off, the next row is sent already
+	if (matrixSkipRows)
+	{
+		matrixSkipRows--;
+		return;
+	}
+	
 	// enable led matrix (switch on)
 	enableMatrix();
 	
@@ -238,6 +424,8 @@ ISR(TIMER2_OVF_vect)
 	if (actualRow == 12)
 	{
 		actualRow = 0;
+		// last row is shown: skip frames after it
+		matrixSkipRows = 12 * matrixFrameSkip;
 	}
 					
 	// switch dot and char leds on
@@ -301,8 +489,8 @@ ISR(TIMER2_COMPA_vect)
 			break;
 	}
 	
-	// set new compare value for pwm
-	OCR2A = systemConfig.displayBrightness;
+	// set new compare value for pwm of row, which is loaded at next overflow
+	OCR2A = rowDuty[actualRow];
 }
 
 // set matrix to total darkness
@@ -317,6 +505,110 @@ void setMatrixDark()
 	}
 }
 
+// count lit leds of a row value
+uint8_t countMatrixLeds(uint8_t value)
+{
+	uint8_t count = 0;
+	
+	// delete lowest set bit until value is zero
+	while (value)
+	{
+		value &= value - 1;
+		count++;
+	}
+	return count;
+}
+
+// calculate pwm value of each row from display pwm value, called with every change of brightness
+// - dense rows get a higher pwm value (voltage drop of the row driver)
+// - all rows are scaled down, if the estimated current is over MATRIX_CURRENT_LIMIT
+void calculateRowDuty(uint8_t pwmValue)
+{
+	uint8_t i = 0;
+	uint8_t leds = 0;
+	uint16_t duty = 0;
+	uint16_t scale = 256;
+	uint32_t current = 0;
+	uint8_t newDuty[12];
+	
+	for(i = 0; i<12; i++)
+	{
+		// lit leds of row (12 matrix leds and dot or char)
+		leds = countMatrixLeds(actualMatrix[i].high) + countMatrixLeds(actualMatrix[i].low & 0xF0);
+		if (((i < 4) && (acutalDot & (0x02 << i))) || (i == 4))
+		{
+			leds++;
+		}
+		
+		// compensation of dense rows
+		duty = ((uint32_t)pwmValue * (256 + leds * MATRIX_DENSE_COMPENSATION)) >> 8;
+		if (duty > PWMVALUE_MAXIMUM)
+		{
+			duty = PWMVALUE_MAXIMUM;
+		}
+		newDuty[i] = duty;
+		
+		// sum of leds * duty
+		current += (uint16_t)leds * duty;
+	}
+	
+	// average current: every row is on for 1/12 of the time
+	current = (current * MATRIX_LED_CURRENT) / (255UL * 12);
+	
+	// scale all rows down to the current limit
+	if (current > MATRIX_CURRENT_LIMIT)
+	{
+		scale = ((uint32_t)MATRIX_CURRENT_LIMIT * 256) / current;
+		matrixCurrent = MATRIX_CURRENT_LIMIT;
+	}
+	else
+	{
+		matrixCurrent = current;
+	}
+	
+	for(i = 0; i<12; i++)
+	{
+		duty = ((uint16_t)newDuty[i] * scale) >> 8;
+		if (duty < PWMVALUE_MINIMUM)
+		{
+			duty = PWMVALUE_MINIMUM;
+		}
+		// one byte, read by timer 2 interrupt
+		rowDuty[i] = duty;
+	}
+}
+
+// get estimated average current of matrix in mA
+uint16_t getMatrixCurrent(void)
+{
+	return matrixCurrent;
+}
+
+// reduce lit leds to every second led (checkerboard), used at low supply voltage
+void setMatrixLedLimit(uint8_t limit)
+{
+	matrixLedLimit = limit;
+}
+
+// set one row of matrix to a 12 bit value (saturated)
+void setMatrixRowValue(uint8_t row, uint16_t value)
+{
+	// limitation
+	if (value > 0x0FFF)
+	{
+		value = 0x0FFF;
+	}
+	actualMatrix[row].high	= value >> 4;
+	actualMatrix[row].low	= (value << 4) & 0xF0;
+}
+
+// add a 8 bit value to the right nibbles of a row (4 bit in high and low byte)
+void addMatrixRowValue(uint8_t row, uint8_t value)
+{
+	actualMatrix[row].high	|= (value >> 4) & 0x0F;
+	actualMatrix[row].low	|= (value << 4) & 0xF0;
+}
+
 // set matrix to total brightness
 void setMatrixBright()
 {
@@ -345,7 +637,7 @@ void actualizeMatrixWithSystemTime()
 	// check straight pie (0) or shift pie (1)
 	if(systemConfig.displaySetting & 0x01)
 	{
-		add = -2;
+		add = -systemConfig.pieShift;
 	}
 		
 	// it is exactly full hour, half and quarter past, quarter to
@@ -770,1800 +1062,327 @@ void actualizeMatrixWithSystemTime()
 		systemConfig.displayStatus = DISPLAY_STATE_DARK;
 	
 		// actualize matrix information
-		displayMatrixInformation(0);
+		displayMatrixInformation();
 	}
 }
 
-// actualize 'actualMatrix' Register with squares or no sequence
-void actualizeMatrixWithSearchingSequence()
+// actualize 'actualMatrix' Register with system time in 00 lbr 00 mode
+// hour in row 0 to 4 and minute in row 6 to 10
+void actualizeMatrixWithTimeNumber(void)
+{
+	// actualize display status
+	systemConfig.displayStatus = DISPLAY_STATE_TIME_NUMBER;
+	
+	// minutes are shown completely: no active dot
+	acutalDot = 0;
+	
+	setMatrixDark();
+	drawMatrixNumber(0, 2, systemTime.hour, 2);
+	drawMatrixNumber(6, 2, systemTime.minute, 2);
+}
+
+// actualize 'actualMatrix' Register with system date in 00 lbr 00 mode
+// day in row 0 to 4 and month in row 6 to 10
+void actualizeMatrixWithDateNumber(void)
+{
+	// actualize display status
+	systemConfig.displayStatus = DISPLAY_STATE_DATE_NUMBER;
+	
+	// no active dot
+	acutalDot = 0;
+	
+	setMatrixDark();
+	drawMatrixNumber(0, 2, systemTime.day, 2);
+	drawMatrixNumber(6, 2, systemTime.month, 2);
+}
+
+// set square (ring) of matrix, ring 0 is the outer square and ring 5 the inner square
+void setMatrixSquare(uint8_t ring)
 {
 	uint8_t i = 0;
-	static uint8_t state = 0;
-	// check searching mode: square (0) or no sequence (1)
-	// searching mode: no sequence (1)
-	if(systemConfig.displaySetting & 0x80)
+	// columns of ring: outer columns and all columns between (bit 11 is left column)
+	uint16_t sides = (0x0800 >> ring) | (0x0001 << ring);
+	uint16_t full = (0x0FFF >> ring) & (0x0FFF << ring);
+	
+	for(i = 0; i<12; i++)
 	{
-		// set matrix dark
-		setMatrixDark();
-		
-		// no sequence
-		acutalDot = 0b00000000;
-		/*// display dot session
-		switch(state)
+		// top and bottom line of square
+		if((i == ring) || (i == 11 - ring))
 		{
-			case 0:
-			// first dot
-			acutalDot = 0b00010000;
-			break;
-			case 1:
-			// second dot
-			acutalDot = 0b00001000;
-			break;
-			case 2:
-			// third dot
-			acutalDot = 0b00000100;
-			break;
-			case 3:
-			// forth dot
-			acutalDot = 0b00000010;
-			break;
-			case 4:
-			// third dot
-			acutalDot = 0b00000100;
-			break;
-			case 5:
-			// second dot
-			acutalDot = 0b00001000;
-			break;
-			default:
-			// no dot
-			acutalDot = 0b00000000;
-			break;		
+			setMatrixRowValue(i, full);
 		}
-			
-		// increment state
-		state++;
-		// reset state
-		if (state == 6)
+		// left and right side of square
+		else if((i > ring) && (i < 11 - ring))
 		{
-			state = 0;
-		}*/
-	}
-		
-	// searching mode: square (0)
-	else
-	{	
-		// display square session
-		switch(state)
-		{
-			case 0:
-			// first square
-			actualMatrix[0].high	= 0b11111111;
-			actualMatrix[0].low		= 0b11110000;
-			actualMatrix[11].high	= 0b11111111;
-			actualMatrix[11].low	= 0b11110000;
-			for(i = 1; i<11; i++)
-			{
-				actualMatrix[i].high = 0b10000000;
-				actualMatrix[i].low	 = 0b00010000;
-			}
-			acutalDot = 0b00010010;
-			break;
-			case 1:
-			// second square
-			actualMatrix[0].high	= 0b00000000;
-			actualMatrix[0].low		= 0b00000000;
-			actualMatrix[11].high	= 0b00000000;
-			actualMatrix[11].low	= 0b00000000;
-			actualMatrix[1].high	= 0b01111111;
-			actualMatrix[1].low		= 0b11100000;
-			actualMatrix[10].high	= 0b01111111;
-			actualMatrix[10].low	= 0b11100000;
-			for(i = 2; i<10; i++)
-			{
-				actualMatrix[i].high = 0b01000000;
-				actualMatrix[i].low	 = 0b00100000;
-			}
-			acutalDot = 0b00001100;
-			break;
-			case 2:
-			// third square
-			actualMatrix[0].high	= 0b00000000;
-			actualMatrix[0].low		= 0b00000000;
-			actualMatrix[1].high	= 0b00000000;
-			actualMatrix[1].low		= 0b00000000;
-			actualMatrix[10].high	= 0b00000000;
-			actualMatrix[10].low	= 0b00000000;
-			actualMatrix[11].high	= 0b00000000;
-			actualMatrix[11].low	= 0b00000000;
-			actualMatrix[2].high	= 0b00111111;
-			actualMatrix[2].low		= 0b11000000;
-			actualMatrix[9].high	= 0b00111111;
-			actualMatrix[9].low		= 0b11000000;
-			for(i = 3; i<9; i++)
-			{
-				actualMatrix[i].high = 0b00100000;
-				actualMatrix[i].low	 = 0b01000000;
-			}
-			acutalDot = 0b00010010;
-			break;
-			case 3:
-			// fourth square
-			actualMatrix[0].high	= 0b00000000;
-			actualMatrix[0].low		= 0b00000000;
-			actualMatrix[1].high	= 0b00000000;
-			actualMatrix[1].low		= 0b00000000;
-			actualMatrix[2].high	= 0b00000000;
-			actualMatrix[2].low		= 0b00000000;
-			actualMatrix[9].high	= 0b00000000;
-			actualMatrix[9].low		= 0b00000000;
-			actualMatrix[10].high	= 0b00000000;
-			actualMatrix[10].low	= 0b00000000;
-			actualMatrix[11].high	= 0b00000000;
-			actualMatrix[11].low	= 0b00000000;
-			actualMatrix[3].high	= 0b00011111;
-			actualMatrix[3].low		= 0b10000000;
-			actualMatrix[8].high	= 0b00011111;
-			actualMatrix[8].low		= 0b10000000;
-			for(i = 4; i<8; i++)
-			{
-				actualMatrix[i].high = 0b00010000;
-				actualMatrix[i].low	 = 0b10000000;
-			}
-			acutalDot = 0b00001100;
-			break;
-			case 4:
-			// finfth square
-			actualMatrix[0].high	= 0b00000000;
-			actualMatrix[0].low		= 0b00000000;
-			actualMatrix[1].high	= 0b00000000;
-			actualMatrix[1].low		= 0b00000000;
-			actualMatrix[2].high	= 0b00000000;
-			actualMatrix[2].low		= 0b00000000;
-			actualMatrix[3].high	= 0b00000000;
-			actualMatrix[3].low		= 0b00000000;
-			actualMatrix[8].high	= 0b00000000;
-			actualMatrix[8].low		= 0b00000000;
-			actualMatrix[9].high	= 0b00000000;
-			actualMatrix[9].low		= 0b00000000;
-			actualMatrix[10].high	= 0b00000000;
-			actualMatrix[10].low	= 0b00000000;
-			actualMatrix[11].high	= 0b00000000;
-			actualMatrix[11].low	= 0b00000000;
-			actualMatrix[4].high	= 0b00001111;
-			actualMatrix[4].low		= 0b00000000;
-			actualMatrix[7].high	= 0b00001111;
-			actualMatrix[7].low		= 0b00000000;
-			for(i = 5; i<7; i++)
-			{
-				actualMatrix[i].high = 0b00001001;
-				actualMatrix[i].low	 = 0b0000000;
-			}
-			acutalDot = 0b00010010;
-			break;
-			case 5:
-			// sixth square
-			actualMatrix[0].high	= 0b00000000;
-			actualMatrix[0].low		= 0b00000000;
-			actualMatrix[1].high	= 0b00000000;
-			actualMatrix[1].low		= 0b00000000;
-			actualMatrix[2].high	= 0b00000000;
-			actualMatrix[2].low		= 0b00000000;
-			actualMatrix[3].high	= 0b00000000;
-			actualMatrix[3].low		= 0b00000000;
-			actualMatrix[4].high	= 0b00000000;
-			actualMatrix[4].low		= 0b00000000;
-			actualMatrix[7].high	= 0b00000000;
-			actualMatrix[7].low		= 0b00000000;
-			actualMatrix[8].high	= 0b00000000;
-			actualMatrix[8].low		= 0b00000000;
-			actualMatrix[9].high	= 0b00000000;
-			actualMatrix[9].low		= 0b00000000;
-			actualMatrix[10].high	= 0b00000000;
-			actualMatrix[10].low	= 0b00000000;
-			actualMatrix[11].high	= 0b00000000;
-			actualMatrix[11].low	= 0b00000000;
-			actualMatrix[5].high	= 0b00000110;
-			actualMatrix[5].low		= 0b00000000;
-			actualMatrix[6].high	= 0b00000110;
-			actualMatrix[6].low		= 0b00000000;
-			acutalDot = 0b00001100;
-			break;
-			case 6:
-			// finfth square
-			actualMatrix[0].high	= 0b00000000;
-			actualMatrix[0].low		= 0b00000000;
-			actualMatrix[1].high	= 0b00000000;
-			actualMatrix[1].low		= 0b00000000;
-			actualMatrix[2].high	= 0b00000000;
-			actualMatrix[2].low		= 0b00000000;
-			actualMatrix[3].high	= 0b00000000;
-			actualMatrix[3].low		= 0b00000000;
-			actualMatrix[8].high	= 0b00000000;
-			actualMatrix[8].low		= 0b00000000;
-			actualMatrix[9].high	= 0b00000000;
-			actualMatrix[9].low		= 0b00000000;
-			actualMatrix[10].high	= 0b00000000;
-			actualMatrix[10].low	= 0b00000000;
-			actualMatrix[11].high	= 0b00000000;
-			actualMatrix[11].low	= 0b00000000;
-			actualMatrix[4].high	= 0b00001111;
-			actualMatrix[4].low		= 0b00000000;
-			actualMatrix[7].high	= 0b00001111;
-			actualMatrix[7].low		= 0b00000000;
-			for(i = 5; i<7; i++)
-			{
-				actualMatrix[i].high = 0b00001001;
-				actualMatrix[i].low	 = 0b0000000;
-			}
-			acutalDot = 0b00010010;
-			break;
-			case 7:
-			// fourth square
-			actualMatrix[0].high	= 0b00000000;
-			actualMatrix[0].low		= 0b00000000;
-			actualMatrix[1].high	= 0b00000000;
-			actualMatrix[1].low		= 0b00000000;
-			actualMatrix[2].high	= 0b00000000;
-			actualMatrix[2].low		= 0b00000000;
-			actualMatrix[9].high	= 0b00000000;
-			actualMatrix[9].low		= 0b00000000;
-			actualMatrix[10].high	= 0b00000000;
-			actualMatrix[10].low	= 0b00000000;
-			actualMatrix[11].high	= 0b00000000;
-			actualMatrix[11].low	= 0b00000000;
-			actualMatrix[3].high	= 0b00011111;
-			actualMatrix[3].low		= 0b10000000;
-			actualMatrix[8].high	= 0b00011111;
-			actualMatrix[8].low		= 0b10000000;
-			for(i = 4; i<8; i++)
-			{
-				actualMatrix[i].high = 0b00010000;
-				actualMatrix[i].low	 = 0b10000000;
-			}
-			acutalDot = 0b00001100;
-			break;
-			case 8:
-			// third square
-			actualMatrix[0].high	= 0b00000000;
-			actualMatrix[0].low		= 0b00000000;
-			actualMatrix[1].high	= 0b00000000;
-			actualMatrix[1].low		= 0b00000000;
-			actualMatrix[10].high	= 0b00000000;
-			actualMatrix[10].low	= 0b00000000;
-			actualMatrix[11].high	= 0b00000000;
-			actualMatrix[11].low	= 0b00000000;
-			actualMatrix[2].high	= 0b00111111;
-			actualMatrix[2].low		= 0b11000000;
-			actualMatrix[9].high	= 0b00111111;
-			actualMatrix[9].low		= 0b11000000;
-			for(i = 3; i<9; i++)
-			{
-				actualMatrix[i].high = 0b00100000;
-				actualMatrix[i].low	 = 0b01000000;
-			}
-			acutalDot = 0b00010010;
-			break;
-			case 9:
-			// second square
-			actualMatrix[0].high	= 0b00000000;
-			actualMatrix[0].low		= 0b00000000;
-			actualMatrix[11].high	= 0b00000000;
-			actualMatrix[11].low	= 0b00000000;
-			actualMatrix[1].high	= 0b01111111;
-			actualMatrix[1].low		= 0b11100000;
-			actualMatrix[10].high	= 0b01111111;
-			actualMatrix[10].low	= 0b11100000;
-			for(i = 2; i<10; i++)
-			{
-				actualMatrix[i].high = 0b01000000;
-				actualMatrix[i].low	 = 0b00100000;
-			}
-			acutalDot = 0b00001100;
-			break;
-			default:
-			// set matrix dark
-			setMatrixDark();
-			// no dot
-			acutalDot = 0b00000000;
-			break;
+			setMatrixRowValue(i, sides);
 		}
-
-		// increment state
-		state++;
-		// reset state
-		if (state == 10)
+		// outside of square
+		else
 		{
-			state = 0;
+			setMatrixRowValue(i, 0);
 		}
 	}
 }
 
-// actualize 'actualMatrix' Register with in menu mode
-void actualizeMatrixInMenuMode(void)
+// thread: searching sequence with squares or no sequence, shown while no time is available
+// the squares move from outside to inside and back, every step takes SEARCHING_STEP_TIME
+uint8_t threadSearchingSequence(void)
 {
-	// toggle flag for blinking sequence
-	static uint8_t toggleFlag = 1;
+	static struct pt pt;
+	static uint8_t step = 0;
 	
-	if (toggleFlag >= 1)
-	{
-		toggleFlag = 0;
-	}
-	else
-	{
-		toggleFlag++;
-	}
+	PT_BEGIN(&pt);
 	
-	switch(systemConfig.displayStatus)
+	for(step = 0; step<10; step++)
 	{
-		// show version
-		case DISPLAY_STATE_MENU_VERSION:
-		{
-			// display a VER lbr 003			
-			actualMatrix[0].high	= 0xAE;
-			actualMatrix[0].low		= 0xC0;
-			actualMatrix[1].high	= 0xA8;
-			actualMatrix[1].low		= 0xA0;
-			actualMatrix[2].high	= 0xAC;
-			actualMatrix[2].low		= 0xC0;
-			actualMatrix[3].high	= 0xA8;
-			actualMatrix[3].low		= 0xA0;
-			actualMatrix[4].high	= 0x4E;
-			actualMatrix[4].low		= 0xA0;
-			actualMatrix[5].high	= 0;
-			actualMatrix[5].low		= 0;
-			actualMatrix[6].high	= 0xEE;
-			actualMatrix[6].low		= 0xE0;
-			actualMatrix[7].high	= 0xAA;
-			actualMatrix[7].low		= 0x20;
-			actualMatrix[8].high	= 0xAA;
-			actualMatrix[8].low		= 0xE0;
-			actualMatrix[9].high	= 0xAA;
-			actualMatrix[9].low		= 0x20;
-			actualMatrix[10].high	= 0xEE;
-			actualMatrix[10].low	= 0xE0;
-			actualMatrix[11].high	= 0x00;
-			actualMatrix[11].low	= 0x00;
-			break;
-		}
+		// wait for searching mode: no menu and no time information available
+		PT_WAIT_UNTIL(&pt, !(systemConfig.status & 0x09));
 		
-		// time mode
-		case DISPLAY_STATE_MENU_TIME_MODE:
+		// check searching mode: square (0) or no sequence (1)
+		// searching mode: no sequence (1)
+		if(systemConfig.displaySetting & 0x80)
 		{
-			// display a TIME
-			actualMatrix[0].high	= 0xEA;
-			actualMatrix[0].low		= 0xB0;
-			actualMatrix[1].high	= 0x4B;
-			actualMatrix[1].low		= 0xA0;
-			actualMatrix[2].high	= 0x4A;
-			actualMatrix[2].low		= 0xB0;
-			actualMatrix[3].high	= 0x4A;
-			actualMatrix[3].low		= 0xA0;
-			actualMatrix[4].high	= 0x4A;
-			actualMatrix[4].low		= 0xB0;
-			actualMatrix[5].high	= 0;
-			actualMatrix[5].low		= 0;
-			actualMatrix[6].high	= 0x00;
-			actualMatrix[6].low		= 0x00;
-			actualMatrix[7].high	= 0x00;
-			actualMatrix[7].low		= 0x00;
-			actualMatrix[8].high	= 0x00;
-			actualMatrix[8].low		= 0x00;
-			actualMatrix[9].high	= 0x00;
-			actualMatrix[9].low		= 0x00;
-			actualMatrix[10].high	= 0x00;
-			actualMatrix[10].low	= 0x00;
-			actualMatrix[11].high	= 0x00;
-			actualMatrix[11].low	= 0x00;
-			break;		
-		}
-		
-		// automatic mode
-		case DISPLAY_STATE_MENU_AUTO_MODE:
-		{
-			// display a TIME lbr AUT.
-			actualMatrix[0].high	= 0xEA;
-			actualMatrix[0].low		= 0xB0;
-			actualMatrix[1].high	= 0x4B;
-			actualMatrix[1].low		= 0xA0;
-			actualMatrix[2].high	= 0x4A;
-			actualMatrix[2].low		= 0xB0;
-			actualMatrix[3].high	= 0x4A;
-			actualMatrix[3].low		= 0xA0;
-			actualMatrix[4].high	= 0x4A;
-			actualMatrix[4].low		= 0xB0;
-			actualMatrix[5].high	= 0;
-			actualMatrix[5].low		= 0;
-			actualMatrix[6].high	= 0x4A;
-			actualMatrix[6].low		= 0xE0;
-			actualMatrix[7].high	= 0xAA;
-			actualMatrix[7].low		= 0x40;
-			actualMatrix[8].high	= 0xEA;
-			actualMatrix[8].low		= 0x40;
-			actualMatrix[9].high	= 0xAA;
-			actualMatrix[9].low		= 0x40;
-			actualMatrix[10].high	= 0xAE;
-			actualMatrix[10].low	= 0x50;
-			actualMatrix[11].high	= 0x00;
-			actualMatrix[11].low	= 0x00;
-			break;		
-		}
-		
-		// search automatic mode - cancel blink
-		case DISPLAY_STATE_MENU_AUTO_CANCEL:
-		{
-			if (toggleFlag == 0)
-			{
-				// display a AUT. lbr X ?
-				actualMatrix[0].high	= 0x4A;
-				actualMatrix[0].low		= 0xE0;
-				actualMatrix[1].high	= 0xAA;
-				actualMatrix[1].low		= 0x40;
-				actualMatrix[2].high	= 0xEA;
-				actualMatrix[2].low		= 0x40;
-				actualMatrix[3].high	= 0xAA;
-				actualMatrix[3].low		= 0x40;
-				actualMatrix[4].high	= 0xAE;
-				actualMatrix[4].low		= 0x50;
-				actualMatrix[5].high	= 0;
-				actualMatrix[5].low		= 0;
-				actualMatrix[6].high	= 0;
-				actualMatrix[6].low		= 0;
-				actualMatrix[7].high	= 0x88;
-				actualMatrix[7].low		= 0x10;
-				actualMatrix[8].high	= 0x50;
-				actualMatrix[8].low		= 0x10;
-				actualMatrix[9].high	= 0x21;
-				actualMatrix[9].low		= 0x20;
-				actualMatrix[10].high	= 0x50;
-				actualMatrix[10].low	= 0xA0;
-				actualMatrix[11].high	= 0x88;
-				actualMatrix[11].low	= 0x40;
-			}
-			else
-			{
-				// display a AUT. lbr X ?
-				actualMatrix[0].high	= 0x4A;
-				actualMatrix[0].low		= 0xE0;
-				actualMatrix[1].high	= 0xAA;
-				actualMatrix[1].low		= 0x40;
-				actualMatrix[2].high	= 0xEA;
-				actualMatrix[2].low		= 0x40;
-				actualMatrix[3].high	= 0xAA;
-				actualMatrix[3].low		= 0x40;
-				actualMatrix[4].high	= 0xAE;
-				actualMatrix[4].low		= 0x50;
-				actualMatrix[5].high	= 0;
-				actualMatrix[5].low		= 0;
-				actualMatrix[6].high	= 0;
-				actualMatrix[6].low		= 0;
-				actualMatrix[7].high	= 0x00;
-				actualMatrix[7].low		= 0x10;
-				actualMatrix[8].high	= 0x00;
-				actualMatrix[8].low		= 0x10;
-				actualMatrix[9].high	= 0x01;
-				actualMatrix[9].low		= 0x20;
-				actualMatrix[10].high	= 0x00;
-				actualMatrix[10].low	= 0xA0;
-				actualMatrix[11].high	= 0x00;
-				actualMatrix[11].low	= 0x40;
-			}
-			break;
-		}
-		
-		// search automatic mode - ok blink
-		case DISPLAY_STATE_MENU_AUTO_OK:
-		{
-			if (toggleFlag == 0)
-			{
-				// display a AUT. lbr X ?
-				actualMatrix[0].high	= 0x4A;
-				actualMatrix[0].low		= 0xE0;
-				actualMatrix[1].high	= 0xAA;
-				actualMatrix[1].low		= 0x40;
-				actualMatrix[2].high	= 0xEA;
-				actualMatrix[2].low		= 0x40;
-				actualMatrix[3].high	= 0xAA;
-				actualMatrix[3].low		= 0x40;
-				actualMatrix[4].high	= 0xAE;
-				actualMatrix[4].low		= 0x50;
-				actualMatrix[5].high	= 0;
-				actualMatrix[5].low		= 0;
-				actualMatrix[6].high	= 0;
-				actualMatrix[6].low		= 0;
-				actualMatrix[7].high	= 0x88;
-				actualMatrix[7].low		= 0x10;
-				actualMatrix[8].high	= 0x50;
-				actualMatrix[8].low		= 0x10;
-				actualMatrix[9].high	= 0x21;
-				actualMatrix[9].low		= 0x20;
-				actualMatrix[10].high	= 0x50;
-				actualMatrix[10].low	= 0xA0;
-				actualMatrix[11].high	= 0x88;
-				actualMatrix[11].low	= 0x40;
-			}
-			else
-			{
-				// display a AUT. lbr X ?
-				actualMatrix[0].high	= 0x4A;
-				actualMatrix[0].low		= 0xE0;
-				actualMatrix[1].high	= 0xAA;
-				actualMatrix[1].low		= 0x40;
-				actualMatrix[2].high	= 0xEA;
-				actualMatrix[2].low		= 0x40;
-				actualMatrix[3].high	= 0xAA;
-				actualMatrix[3].low		= 0x40;
-				actualMatrix[4].high	= 0xAE;
-				actualMatrix[4].low		= 0x50;
-				actualMatrix[5].high	= 0;
-				actualMatrix[5].low		= 0;
-				actualMatrix[6].high	= 0;
-				actualMatrix[6].low		= 0;
-				actualMatrix[7].high	= 0x88;
-				actualMatrix[7].low		= 0x00;
-				actualMatrix[8].high	= 0x50;
-				actualMatrix[8].low		= 0x00;
-				actualMatrix[9].high	= 0x20;
-				actualMatrix[9].low		= 0x00;
-				actualMatrix[10].high	= 0x50;
-				actualMatrix[10].low	= 0x00;
-				actualMatrix[11].high	= 0x88;
-				actualMatrix[11].low	= 0x00;
-			}
-			break;
-		}
-					
-		// manual mode
-		case DISPLAY_STATE_MENU_MANUAL_MODE:
-		{
-			// display a TIME lbr MAN
-			actualMatrix[0].high	= 0xEA;
-			actualMatrix[0].low		= 0xB0;
-			actualMatrix[1].high	= 0x4B;
-			actualMatrix[1].low		= 0xA0;
-			actualMatrix[2].high	= 0x4A;
-			actualMatrix[2].low		= 0xB0;
-			actualMatrix[3].high	= 0x4A;
-			actualMatrix[3].low		= 0xA0;
-			actualMatrix[4].high	= 0x4A;
-			actualMatrix[4].low		= 0xB0;
-			actualMatrix[5].high	= 0;
-			actualMatrix[5].low		= 0;
-			actualMatrix[6].high	= 0xA4;
-			actualMatrix[6].low		= 0x90;
-			actualMatrix[7].high	= 0xEA;
-			actualMatrix[7].low		= 0xC0;
-			actualMatrix[8].high	= 0xAE;
-			actualMatrix[8].low		= 0x90;
-			actualMatrix[9].high	= 0xAA;
-			actualMatrix[9].low		= 0xB0;
-			actualMatrix[10].high	= 0xAA;
-			actualMatrix[10].low	= 0x90;
-			actualMatrix[11].high	= 0x00;
-			actualMatrix[11].low	= 0x00;
-			break;
-		}
-				
-		// set time manual - cancel blink
-		case DISPLAY_STATE_MENU_MANUAL_CANCEL:
-		{
-			if (toggleFlag == 0)
-			{
-				// display a MAN lbr X ?
-				actualMatrix[0].high	= 0xA4;
-				actualMatrix[0].low		= 0x90;
-				actualMatrix[1].high	= 0xEA;
-				actualMatrix[1].low		= 0xC0;
-				actualMatrix[2].high	= 0xAE;
-				actualMatrix[2].low		= 0x90;
-				actualMatrix[3].high	= 0xAA;
-				actualMatrix[3].low		= 0xB0;
-				actualMatrix[4].high	= 0xAA;
-				actualMatrix[4].low		= 0x90;
-				actualMatrix[5].high	= 0;
-				actualMatrix[5].low		= 0;
-				actualMatrix[6].high	= 0;
-				actualMatrix[6].low		= 0;
-				actualMatrix[7].high	= 0x88;
-				actualMatrix[7].low		= 0x10;
-				actualMatrix[8].high	= 0x50;
-				actualMatrix[8].low		= 0x10;
-				actualMatrix[9].high	= 0x21;
-				actualMatrix[9].low		= 0x20;
-				actualMatrix[10].high	= 0x50;
-				actualMatrix[10].low	= 0xA0;
-				actualMatrix[11].high	= 0x88;
-				actualMatrix[11].low	= 0x40;
-			}
-			else
-			{
-				// display a MAN lbr X ?
-				actualMatrix[0].high	= 0xA4;
-				actualMatrix[0].low		= 0x90;
-				actualMatrix[1].high	= 0xEA;
-				actualMatrix[1].low		= 0xC0;
-				actualMatrix[2].high	= 0xAE;
-				actualMatrix[2].low		= 0x90;
-				actualMatrix[3].high	= 0xAA;
-				actualMatrix[3].low		= 0xB0;
-				actualMatrix[4].high	= 0xAA;
-				actualMatrix[4].low		= 0x90;
-				actualMatrix[5].high	= 0;
-				actualMatrix[5].low		= 0;
-				actualMatrix[6].high	= 0;
-				actualMatrix[6].low		= 0;
-				actualMatrix[7].high	= 0x00;
-				actualMatrix[7].low		= 0x10;
-				actualMatrix[8].high	= 0x00;
-				actualMatrix[8].low		= 0x10;
-				actualMatrix[9].high	= 0x01;
-				actualMatrix[9].low		= 0x20;
-				actualMatrix[10].high	= 0x00;
-				actualMatrix[10].low	= 0xA0;
-				actualMatrix[11].high	= 0x00;
-				actualMatrix[11].low	= 0x40;
-			}
-			break;
-		}
-		
-		// search automatic mode - ok blink
-		case DISPLAY_STATE_MENU_MANUAL_OK:
-		{
-			if (toggleFlag == 0)
-			{
-				// display a MAN lbr X ?
-				actualMatrix[0].high	= 0xA4;
-				actualMatrix[0].low		= 0x90;
-				actualMatrix[1].high	= 0xEA;
-				actualMatrix[1].low		= 0xC0;
-				actualMatrix[2].high	= 0xAE;
-				actualMatrix[2].low		= 0x90;
-				actualMatrix[3].high	= 0xAA;
-				actualMatrix[3].low		= 0xB0;
-				actualMatrix[4].high	= 0xAA;
-				actualMatrix[4].low		= 0x90;
-				actualMatrix[5].high	= 0;
-				actualMatrix[5].low		= 0;
-				actualMatrix[6].high	= 0;
-				actualMatrix[6].low		= 0;
-				actualMatrix[7].high	= 0x88;
-				actualMatrix[7].low		= 0x10;
-				actualMatrix[8].high	= 0x50;
-				actualMatrix[8].low		= 0x10;
-				actualMatrix[9].high	= 0x21;
-				actualMatrix[9].low		= 0x20;
-				actualMatrix[10].high	= 0x50;
-				actualMatrix[10].low	= 0xA0;
-				actualMatrix[11].high	= 0x88;
-				actualMatrix[11].low	= 0x40;
-			}
-			else
-			{
-				// display a MAN lbr X ?
-				actualMatrix[0].high	= 0xA4;
-				actualMatrix[0].low		= 0x90;
-				actualMatrix[1].high	= 0xEA;
-				actualMatrix[1].low		= 0xC0;
-				actualMatrix[2].high	= 0xAE;
-				actualMatrix[2].low		= 0x90;
-				actualMatrix[3].high	= 0xAA;
-				actualMatrix[3].low		= 0xB0;
-				actualMatrix[4].high	= 0xAA;
-				actualMatrix[4].low		= 0x90;
-				actualMatrix[5].high	= 0;
-				actualMatrix[5].low		= 0;
-				actualMatrix[6].high	= 0;
-				actualMatrix[6].low		= 0;
-				actualMatrix[7].high	= 0x88;
-				actualMatrix[7].low		= 0x00;
-				actualMatrix[8].high	= 0x50;
-				actualMatrix[8].low		= 0x00;
-				actualMatrix[9].high	= 0x20;
-				actualMatrix[9].low		= 0x00;
-				actualMatrix[10].high	= 0x50;
-				actualMatrix[10].low	= 0x00;
-				actualMatrix[11].high	= 0x88;
-				actualMatrix[11].low	= 0x00;
-			}
-			break;
-		}		
-				
-		// set hour manual
-		case DISPLAY_STATE_MENU_SET_HOUR:
-		{
-			if (toggleFlag == 0)
-			{
-				// display a time to set with ok and cancel
-				actualMatrix[0].high	= ((setTime.hour >> 4) & 0x0F) | 0x28;
-				actualMatrix[0].low		= (setTime.hour << 4) & 0xF0;
-				actualMatrix[1].high	= ((setTime.minute >> 4) & 0x0F) | 0x28;
-				actualMatrix[1].low		= (setTime.minute << 4) & 0xF0;
-				actualMatrix[2].high	= ((setTime.second >> 4) & 0x0F) | 0x38;
-				actualMatrix[2].low		= (setTime.second << 4) & 0xF0;
-				actualMatrix[3].high	= 0x28;
-				actualMatrix[3].low		= 0x00;
-				actualMatrix[4].high	= ((setTime.day >> 4) & 0x0F) | 0x28;
-				actualMatrix[4].low		= (setTime.day << 4) & 0xF0;
-				actualMatrix[5].high	= (setTime.month >> 4) & 0x0F;
-				actualMatrix[5].low		= (setTime.month << 4) & 0xF0;
-				actualMatrix[6].high	= (setTime.year >> 4) & 0x0F;
-				actualMatrix[6].low		= (setTime.year << 4) & 0xF0;
-				actualMatrix[7].high	= (setTime.weekday >> 4) & 0x0F;
-				actualMatrix[7].low		= (setTime.weekday << 4) & 0xF0;
-				actualMatrix[8].high	= 0;
-				actualMatrix[8].low		= 0;
-				actualMatrix[9].high	= 0x50;
-				actualMatrix[9].low		= 0x20;
-				actualMatrix[10].high	= 0x21;
-				actualMatrix[10].low	= 0x40;
-				actualMatrix[11].high	= 0x50;
-				actualMatrix[11].low	= 0x80;
-			}
-			else
-			{
-				// display a time to set with ok and cancel
-				actualMatrix[0].high	= ((setTime.hour >> 4) & 0x0F) | 0xA8;
-				actualMatrix[0].low		= (setTime.hour << 4) & 0xF0;
-				actualMatrix[1].high	= ((setTime.minute >> 4) & 0x0F) | 0x28;
-				actualMatrix[1].low		= (setTime.minute << 4) & 0xF0;
-				actualMatrix[2].high	= ((setTime.second >> 4) & 0x0F) | 0x38;
-				actualMatrix[2].low		= (setTime.second << 4) & 0xF0;
-				actualMatrix[3].high	= 0x28;
-				actualMatrix[3].low		= 0x00;
-				actualMatrix[4].high	= ((setTime.day >> 4) & 0x0F) | 0x28;
-				actualMatrix[4].low		= (setTime.day << 4) & 0xF0;
-				actualMatrix[5].high	= (setTime.month >> 4) & 0x0F;
-				actualMatrix[5].low		= (setTime.month << 4) & 0xF0;
-				actualMatrix[6].high	= (setTime.year >> 4) & 0x0F;
-				actualMatrix[6].low		= (setTime.year << 4) & 0xF0;
-				actualMatrix[7].high	= (setTime.weekday >> 4) & 0x0F;
-				actualMatrix[7].low		= (setTime.weekday << 4) & 0xF0;
-				actualMatrix[8].high	= 0;
-				actualMatrix[8].low		= 0;
-				actualMatrix[9].high	= 0x50;
-				actualMatrix[9].low		= 0x20;
-				actualMatrix[10].high	= 0x21;
-				actualMatrix[10].low	= 0x40;
-				actualMatrix[11].high	= 0x50;
-				actualMatrix[11].low	= 0x80;
-			}
-			break;
+			// set matrix dark
+			setMatrixDark();
+			// no sequence
+			acutalDot = 0b00000000;
 		}
-		
-		// set minute manual
-		case DISPLAY_STATE_MENU_SET_MINUTE:
+		// searching mode: square (0)
+		else
 		{
-			if (toggleFlag == 0)
+			// square 0 to 5 and back to square 1
+			if(step < 6)
 			{
-				// display a time to set with ok and cancel
-				actualMatrix[0].high	= ((setTime.hour >> 4) & 0x0F) | 0x44;
-				actualMatrix[0].low		= (setTime.hour << 4) & 0xF0;
-				actualMatrix[1].high	= ((setTime.minute >> 4) & 0x0F) | 0x6C;
-				actualMatrix[1].low		= (setTime.minute << 4) & 0xF0;
-				actualMatrix[2].high	= ((setTime.second >> 4) & 0x0F) | 0x54;
-				actualMatrix[2].low		= (setTime.second << 4) & 0xF0;
-				actualMatrix[3].high	= 0x44;
-				actualMatrix[3].low		= 0;
-				actualMatrix[4].high	= ((setTime.day >> 4) & 0x0F) | 0x44;
-				actualMatrix[4].low		= (setTime.day << 4) & 0xF0;
-				actualMatrix[5].high	= (setTime.month >> 4) & 0x0F;
-				actualMatrix[5].low		= (setTime.month << 4) & 0xF0;
-				actualMatrix[6].high	= (setTime.year >> 4) & 0x0F;
-				actualMatrix[6].low		= (setTime.year << 4) & 0xF0;
-				actualMatrix[7].high	= (setTime.weekday >> 4) & 0x0F;
-				actualMatrix[7].low		= (setTime.weekday << 4) & 0xF0;
-				actualMatrix[8].high	= 0;
-				actualMatrix[8].low		= 0;
-				actualMatrix[9].high	= 0x50;
-				actualMatrix[9].low		= 0x20;
-				actualMatrix[10].high	= 0x21;
-				actualMatrix[10].low	= 0x40;
-				actualMatrix[11].high	= 0x50;
-				actualMatrix[11].low	= 0x80;
+				setMatrixSquare(step);
 			}
 			else
 			{
-				// display a time to set with ok and cancel
-				actualMatrix[0].high	= ((setTime.hour >> 4) & 0x0F) | 0x44;
-				actualMatrix[0].low		= (setTime.hour << 4) & 0xF0;
-				actualMatrix[1].high	= ((setTime.minute >> 4) & 0x0F) | 0xEC;
-				actualMatrix[1].low		= (setTime.minute << 4) & 0xF0;
-				actualMatrix[2].high	= ((setTime.second >> 4) & 0x0F) | 0x54;
-				actualMatrix[2].low		= (setTime.second << 4) & 0xF0;
-				actualMatrix[3].high	= 0x44;
-				actualMatrix[3].low		= 0;
-				actualMatrix[4].high	= ((setTime.day >> 4) & 0x0F) | 0x44;
-				actualMatrix[4].low		= (setTime.day << 4) & 0xF0;
-				actualMatrix[5].high	= (setTime.month >> 4) & 0x0F;
-				actualMatrix[5].low		= (setTime.month << 4) & 0xF0;
-				actualMatrix[6].high	= (setTime.year >> 4) & 0x0F;
-				actualMatrix[6].low		= (setTime.year << 4) & 0xF0;
-				actualMatrix[7].high	= (setTime.weekday >> 4) & 0x0F;
-				actualMatrix[7].low		= (setTime.weekday << 4) & 0xF0;
-				actualMatrix[8].high	= 0;
-				actualMatrix[8].low		= 0;
-				actualMatrix[9].high	= 0x50;
-				actualMatrix[9].low		= 0x20;
-				actualMatrix[10].high	= 0x21;
-				actualMatrix[10].low	= 0x40;
-				actualMatrix[11].high	= 0x50;
-				actualMatrix[11].low	= 0x80;
+				setMatrixSquare(10 - step);
 			}
-			break;
-		}
-		
-		// set second manual
-		case DISPLAY_STATE_MENU_SET_SECOND:
-		{
-			if (toggleFlag == 0)
+			// alternating dots
+			if(step & 0x01)
 			{
-				// display a time to set with ok and cancel
-				actualMatrix[0].high	= ((setTime.hour >> 4) & 0x0F) | 0x38;
-				actualMatrix[0].low		= (setTime.hour << 4) & 0xF0;
-				actualMatrix[1].high	= ((setTime.minute >> 4) & 0x0F) | 0x20;
-				actualMatrix[1].low		= (setTime.minute << 4) & 0xF0;
-				actualMatrix[2].high	= ((setTime.second >> 4) & 0x0F) | 0x38;
-				actualMatrix[2].low		= (setTime.second << 4) & 0xF0;
-				actualMatrix[3].high	= 0x08;
-				actualMatrix[3].low		= 0;
-				actualMatrix[4].high	= ((setTime.day >> 4) & 0x0F) | 0x38;
-				actualMatrix[4].low		= (setTime.day << 4) & 0xF0;
-				actualMatrix[5].high	= (setTime.month >> 4) & 0x0F;
-				actualMatrix[5].low		= (setTime.month << 4) & 0xF0;
-				actualMatrix[6].high	= (setTime.year >> 4) & 0x0F;
-				actualMatrix[6].low		= (setTime.year << 4) & 0xF0;
-				actualMatrix[7].high	= (setTime.weekday >> 4) & 0x0F;
-				actualMatrix[7].low		= (setTime.weekday << 4) & 0xF0;
-				actualMatrix[8].high	= 0;
-				actualMatrix[8].low		= 0;
-				actualMatrix[9].high	= 0x50;
-				actualMatrix[9].low		= 0x20;
-				actualMatrix[10].high	= 0x21;
-				actualMatrix[10].low	= 0x40;
-				actualMatrix[11].high	= 0x50;
-				actualMatrix[11].low	= 0x80;
+				acutalDot = 0b00001100;
 			}
 			else
 			{
-				// display a time to set with ok and cancel
-				actualMatrix[0].high	= ((setTime.hour >> 4) & 0x0F) | 0x38;
-				actualMatrix[0].low		= (setTime.hour << 4) & 0xF0;
-				actualMatrix[1].high	= ((setTime.minute >> 4) & 0x0F) | 0x20;
-				actualMatrix[1].low		= (setTime.minute << 4) & 0xF0;
-				actualMatrix[2].high	= ((setTime.second >> 4) & 0x0F) | 0xB8;
-				actualMatrix[2].low		= (setTime.second << 4) & 0xF0;
-				actualMatrix[3].high	= 0x08;
-				actualMatrix[3].low		= 0;
-				actualMatrix[4].high	= ((setTime.day >> 4) & 0x0F) | 0x38;
-				actualMatrix[4].low		= (setTime.day << 4) & 0xF0;
-				actualMatrix[5].high	= (setTime.month >> 4) & 0x0F;
-				actualMatrix[5].low		= (setTime.month << 4) & 0xF0;
-				actualMatrix[6].high	= (setTime.year >> 4) & 0x0F;
-				actualMatrix[6].low		= (setTime.year << 4) & 0xF0;
-				actualMatrix[7].high	= (setTime.weekday >> 4) & 0x0F;
-				actualMatrix[7].low		= (setTime.weekday << 4) & 0xF0;
-				actualMatrix[8].high	= 0;
-				actualMatrix[8].low		= 0;
-				actualMatrix[9].high	= 0x50;
-				actualMatrix[9].low		= 0x20;
-				actualMatrix[10].high	= 0x21;
-				actualMatrix[10].low	= 0x40;
-				actualMatrix[11].high	= 0x50;
-				actualMatrix[11].low	= 0x80;
+				acutalDot = 0b00010010;
 			}
-			break;
-		}
-			
-		// set day manual
-		case DISPLAY_STATE_MENU_SET_DAY:
-		{
-			if (toggleFlag == 0)
-			{
-				// display a time to set with ok and cancel
-				actualMatrix[0].high	= ((setTime.hour >> 4) & 0x0F) | 0x70;
-				actualMatrix[0].low		= (setTime.hour << 4) & 0xF0;
-				actualMatrix[1].high	= ((setTime.minute >> 4) & 0x0F) | 0x48;
-				actualMatrix[1].low		= (setTime.minute << 4) & 0xF0;
-				actualMatrix[2].high	= ((setTime.second >> 4) & 0x0F) | 0x48;
-				actualMatrix[2].low		= (setTime.second << 4) & 0xF0;
-				actualMatrix[3].high	= 0x48;
-				actualMatrix[3].low		= 0x00;
-				actualMatrix[4].high	= ((setTime.day >> 4) & 0x0F) | 0x70;
-				actualMatrix[4].low		= (setTime.day << 4) & 0xF0;
-				actualMatrix[5].high	= (setTime.month >> 4) & 0x0F;
-				actualMatrix[5].low		= (setTime.month << 4) & 0xF0;
-				actualMatrix[6].high	= (setTime.year >> 4) & 0x0F;
-				actualMatrix[6].low		= (setTime.year << 4) & 0xF0;
-				actualMatrix[7].high	= (setTime.weekday >> 4) & 0x0F;
-				actualMatrix[7].low		= (setTime.weekday << 4) & 0xF0;
-				actualMatrix[8].high	= 0;
-				actualMatrix[8].low		= 0;
-				actualMatrix[9].high	= 0x50;
-				actualMatrix[9].low		= 0x20;
-				actualMatrix[10].high	= 0x21;
-				actualMatrix[10].low	= 0x40;
-				actualMatrix[11].high	= 0x50;
-				actualMatrix[11].low	= 0x80;
-			}
-			else
-			{
-				// display a time to set with ok and cancel
-				actualMatrix[0].high	= ((setTime.hour >> 4) & 0x0F) | 0x70;
-				actualMatrix[0].low		= (setTime.hour << 4) & 0xF0;
-				actualMatrix[1].high	= ((setTime.minute >> 4) & 0x0F) | 0x48;
-				actualMatrix[1].low		= (setTime.minute << 4) & 0xF0;
-				actualMatrix[2].high	= ((setTime.second >> 4) & 0x0F) | 0x48;
-				actualMatrix[2].low		= (setTime.second << 4) & 0xF0;
-				actualMatrix[3].high	= 0x48;
-				actualMatrix[3].low		= 0x00;
-				actualMatrix[4].high	= ((setTime.day >> 4) & 0x0F) | 0xF0;
-				actualMatrix[4].low		= (setTime.day << 4) & 0xF0;
-				actualMatrix[5].high	= (setTime.month >> 4) & 0x0F;
-				actualMatrix[5].low		= (setTime.month << 4) & 0xF0;
-				actualMatrix[6].high	= (setTime.year >> 4) & 0x0F;
-				actualMatrix[6].low		= (setTime.year << 4) & 0xF0;
-				actualMatrix[7].high	= (setTime.weekday >> 4) & 0x0F;
-				actualMatrix[7].low		= (setTime.weekday << 4) & 0xF0;
-				actualMatrix[8].high	= 0;
-				actualMatrix[8].low		= 0;
-				actualMatrix[9].high	= 0x50;
-				actualMatrix[9].low		= 0x20;
-				actualMatrix[10].high	= 0x21;
-				actualMatrix[10].low	= 0x40;
-				actualMatrix[11].high	= 0x50;
-				actualMatrix[11].low	= 0x80;
-			}
-			break;
 		}
 		
-		// set month manual
-		case DISPLAY_STATE_MENU_SET_MONTH:
-		{
-			if (toggleFlag == 0)
-			{
-				// display a time to set with ok and cancel
-				actualMatrix[0].high	= ((setTime.hour >> 4) & 0x0F) | 0x44;
-				actualMatrix[0].low		= (setTime.hour << 4) & 0xF0;
-				actualMatrix[1].high	= ((setTime.minute >> 4) & 0x0F) | 0x6C;
-				actualMatrix[1].low		= (setTime.minute << 4) & 0xF0;
-				actualMatrix[2].high	= ((setTime.second >> 4) & 0x0F) | 0x54;
-				actualMatrix[2].low		= (setTime.second << 4) & 0xF0;
-				actualMatrix[3].high	= 0x44;
-				actualMatrix[3].low		= 0;
-				actualMatrix[4].high	= ((setTime.day >> 4) & 0x0F) | 0x44;
-				actualMatrix[4].low		= (setTime.day << 4) & 0xF0;
-				actualMatrix[5].high	= (setTime.month >> 4) & 0x0F;
-				actualMatrix[5].low		= (setTime.month << 4) & 0xF0;
-				actualMatrix[6].high	= (setTime.year >> 4) & 0x0F;
-				actualMatrix[6].low		= (setTime.year << 4) & 0xF0;
-				actualMatrix[7].high	= (setTime.weekday >> 4) & 0x0F;
-				actualMatrix[7].low		= (setTime.weekday << 4) & 0xF0;
-				actualMatrix[8].high	= 0;
-				actualMatrix[8].low		= 0;
-				actualMatrix[9].high	= 0x50;
-				actualMatrix[9].low		= 0x20;
-				actualMatrix[10].high	= 0x21;
-				actualMatrix[10].low	= 0x40;
-				actualMatrix[11].high	= 0x50;
-				actualMatrix[11].low	= 0x80;
-			}
-			else
-			{
-				// display a time to set with ok and cancel
-				actualMatrix[0].high	= ((setTime.hour >> 4) & 0x0F) | 0x44;
-				actualMatrix[0].low		= (setTime.hour << 4) & 0xF0;
-				actualMatrix[1].high	= ((setTime.minute >> 4) & 0x0F) | 0x6C;
-				actualMatrix[1].low		= (setTime.minute << 4) & 0xF0;
-				actualMatrix[2].high	= ((setTime.second >> 4) & 0x0F) | 0x54;
-				actualMatrix[2].low		= (setTime.second << 4) & 0xF0;
-				actualMatrix[3].high	= 0x44;
-				actualMatrix[3].low		= 0;
-				actualMatrix[4].high	= ((setTime.day >> 4) & 0x0F) | 0x44;
-				actualMatrix[4].low		= (setTime.day << 4) & 0xF0;
-				actualMatrix[5].high	= ((setTime.month >> 4) & 0x0F) | 0x80;
-				actualMatrix[5].low		= (setTime.month << 4) & 0xF0;
-				actualMatrix[6].high	= (setTime.year >> 4) & 0x0F;
-				actualMatrix[6].low		= (setTime.year << 4) & 0xF0;
-				actualMatrix[7].high	= (setTime.weekday >> 4) & 0x0F;
-				actualMatrix[7].low		= (setTime.weekday << 4) & 0xF0;
-				actualMatrix[8].high	= 0;
-				actualMatrix[8].low		= 0;
-				actualMatrix[9].high	= 0x50;
-				actualMatrix[9].low		= 0x20;
-				actualMatrix[10].high	= 0x21;
-				actualMatrix[10].low	= 0x40;
-				actualMatrix[11].high	= 0x50;
-				actualMatrix[11].low	= 0x80;
-			}
-			break;
-		}
+		PT_SLEEP_MS(&pt, SEARCHING_STEP_TIME);
+	}
+	
+	PT_END(&pt);
+}
 
-		// set year manual
-		case DISPLAY_STATE_MENU_SET_YEAR:
-		{
-			if (toggleFlag == 0)
-			{
-				// display a time to set with ok and cancel
-				actualMatrix[0].high	= ((setTime.hour >> 4) & 0x0F) | 0x28;
-				actualMatrix[0].low		= (setTime.hour << 4) & 0xF0;
-				actualMatrix[1].high	= ((setTime.minute >> 4) & 0x0F) | 0x28;
-				actualMatrix[1].low		= (setTime.minute << 4) & 0xF0;
-				actualMatrix[2].high	= ((setTime.second >> 4) & 0x0F) | 0x10;
-				actualMatrix[2].low		= (setTime.second << 4) & 0xF0;
-				actualMatrix[3].high	= 0x10;
-				actualMatrix[3].low		= 0;
-				actualMatrix[4].high	= ((setTime.day >> 4) & 0x0F) | 0x10;
-				actualMatrix[4].low		= (setTime.day << 4) & 0xF0;
-				actualMatrix[5].high	= (setTime.month >> 4) & 0x0F;
-				actualMatrix[5].low		= (setTime.month << 4) & 0xF0;
-				actualMatrix[6].high	= (setTime.year >> 4) & 0x0F;
-				actualMatrix[6].low		= (setTime.year << 4) & 0xF0;
-				actualMatrix[7].high	= (setTime.weekday >> 4) & 0x0F;
-				actualMatrix[7].low		= (setTime.weekday << 4) & 0xF0;
-				actualMatrix[8].high	= 0;
-				actualMatrix[8].low		= 0;
-				actualMatrix[9].high	= 0x50;
-				actualMatrix[9].low		= 0x20;
-				actualMatrix[10].high	= 0x21;
-				actualMatrix[10].low	= 0x40;
-				actualMatrix[11].high	= 0x50;
-				actualMatrix[11].low	= 0x80;
-			}
-			else
-			{
-				// display a time to set with ok and cancel
-				actualMatrix[0].high	= ((setTime.hour >> 4) & 0x0F) | 0x28;
-				actualMatrix[0].low		= (setTime.hour << 4) & 0xF0;
-				actualMatrix[1].high	= ((setTime.minute >> 4) & 0x0F) | 0x28;
-				actualMatrix[1].low		= (setTime.minute << 4) & 0xF0;
-				actualMatrix[2].high	= ((setTime.second >> 4) & 0x0F) | 0x10;
-				actualMatrix[2].low		= (setTime.second << 4) & 0xF0;
-				actualMatrix[3].high	= 0x10;
-				actualMatrix[3].low		= 0;
-				actualMatrix[4].high	= ((setTime.day >> 4) & 0x0F) | 0x10;
-				actualMatrix[4].low		= (setTime.day << 4) & 0xF0;
-				actualMatrix[5].high	= (setTime.month >> 4) & 0x0F;
-				actualMatrix[5].low		= (setTime.month << 4) & 0xF0;
-				actualMatrix[6].high	= ((setTime.year >> 4) & 0x0F) | 0x80;
-				actualMatrix[6].low		= (setTime.year << 4) & 0xF0;
-				actualMatrix[7].high	= (setTime.weekday >> 4) & 0x0F;
-				actualMatrix[7].low		= (setTime.weekday << 4) & 0xF0;
-				actualMatrix[8].high	= 0;
-				actualMatrix[8].low		= 0;
-				actualMatrix[9].high	= 0x50;
-				actualMatrix[9].low		= 0x20;
-				actualMatrix[10].high	= 0x21;
-				actualMatrix[10].low	= 0x40;
-				actualMatrix[11].high	= 0x50;
-				actualMatrix[11].low	= 0x80;
-			}
-			break;
-		}
-		
-		// set weekday manual
-		case DISPLAY_STATE_MENU_SET_WEEKDAY:
-		{
-			if (toggleFlag == 0)
-			{
-				// display a time to set with ok and cancel
-				actualMatrix[0].high	= ((setTime.hour >> 4) & 0x0F) | 0x44;
-				actualMatrix[0].low		= (setTime.hour << 4) & 0xF0;
-				actualMatrix[1].high	= ((setTime.minute >> 4) & 0x0F) | 0x44;
-				actualMatrix[1].low		= (setTime.minute << 4) & 0xF0;
-				actualMatrix[2].high	= ((setTime.second >> 4) & 0x0F) | 0x54;
-				actualMatrix[2].low		= (setTime.second << 4) & 0xF0;
-				actualMatrix[3].high	= 0x54;
-				actualMatrix[3].low		= 0;
-				actualMatrix[4].high	= ((setTime.day >> 4) & 0x0F) | 0x28;
-				actualMatrix[4].low		= (setTime.day << 4) & 0xF0;
-				actualMatrix[5].high	= (setTime.month >> 4) & 0x0F;
-				actualMatrix[5].low		= (setTime.month << 4) & 0xF0;
-				actualMatrix[6].high	= (setTime.year >> 4) & 0x0F;
-				actualMatrix[6].low		= (setTime.year << 4) & 0xF0;
-				actualMatrix[7].high	= (setTime.weekday >> 4) & 0x0F;
-				actualMatrix[7].low		= (setTime.weekday << 4) & 0xF0;
-				actualMatrix[8].high	= 0;
-				actualMatrix[8].low		= 0;
-				actualMatrix[9].high	= 0x50;
-				actualMatrix[9].low		= 0x20;
-				actualMatrix[10].high	= 0x21;
-				actualMatrix[10].low	= 0x40;
-				actualMatrix[11].high	= 0x50;
-				actualMatrix[11].low	= 0x80;
-			}
-			else
-			{
-				// display a time to set with ok and cancel
-				actualMatrix[0].high	= ((setTime.hour >> 4) & 0x0F) | 0x44;
-				actualMatrix[0].low		= (setTime.hour << 4) & 0xF0;
-				actualMatrix[1].high	= ((setTime.minute >> 4) & 0x0F) | 0x44;
-				actualMatrix[1].low		= (setTime.minute << 4) & 0xF0;
-				actualMatrix[2].high	= ((setTime.second >> 4) & 0x0F) | 0x54;
-				actualMatrix[2].low		= (setTime.second << 4) & 0xF0;
-				actualMatrix[3].high	= 0x54;
-				actualMatrix[3].low		= 0;
-				actualMatrix[4].high	= ((setTime.day >> 4) & 0x0F) | 0x28;
-				actualMatrix[4].low		= (setTime.day << 4) & 0xF0;
-				actualMatrix[5].high	= (setTime.month >> 4) & 0x0F;
-				actualMatrix[5].low		= (setTime.month << 4) & 0xF0;
-				actualMatrix[6].high	= (setTime.year >> 4) & 0x0F;
-				actualMatrix[6].low		= (setTime.year << 4) & 0xF0;
-				actualMatrix[7].high	= ((setTime.weekday >> 4) & 0x0F) | 0x80;
-				actualMatrix[7].low		= (setTime.weekday << 4) & 0xF0;
-				actualMatrix[8].high	= 0;
-				actualMatrix[8].low		= 0;
-				actualMatrix[9].high	= 0x50;
-				actualMatrix[9].low		= 0x20;
-				actualMatrix[10].high	= 0x21;
-				actualMatrix[10].low	= 0x40;
-				actualMatrix[11].high	= 0x50;
-				actualMatrix[11].low	= 0x80;
-			}
-			break;
-		}
+// thread: blinking sequence in menu mode, toggles every MENU_BLINK_TIME
+uint8_t threadMenuBlink(void)
+{
+	static struct pt pt;
+	
+	PT_BEGIN(&pt);
+	
+	// wait for menu mode
+	PT_WAIT_UNTIL(&pt, systemConfig.status & 0x08);
+	
+	// blink while menu mode is active
+	while(systemConfig.status & 0x08)
+	{
+		// toggle flag for blinking sequence
+		toggleFlag ^= 0x01;
+		// redraw menu
+		actualizeMatrixInMenuMode();
 		
-		// set manual time - cancel blinking
-		case DISPLAY_STATE_MENU_SET_CANCEL:
-		{
-			if (toggleFlag == 0)
-			{
-				// display a time to set with ok and cancel
-				actualMatrix[0].high	= (setTime.hour >> 4) & 0x0F;
-				actualMatrix[0].low		= (setTime.hour << 4) & 0xF0;
-				actualMatrix[1].high	= (setTime.minute >> 4) & 0x0F;
-				actualMatrix[1].low		= (setTime.minute << 4) & 0xF0;
-				actualMatrix[2].high	= (setTime.second >> 4) & 0x0F;
-				actualMatrix[2].low		= (setTime.second << 4) & 0xF0;
-				actualMatrix[3].high	= 0;
-				actualMatrix[3].low		= 0;
-				actualMatrix[4].high	= (setTime.day >> 4) & 0x0F;
-				actualMatrix[4].low		= (setTime.day << 4) & 0xF0;
-				actualMatrix[5].high	= (setTime.month >> 4) & 0x0F;
-				actualMatrix[5].low		= (setTime.month << 4) & 0xF0;
-				actualMatrix[6].high	= (setTime.year >> 4) & 0x0F;
-				actualMatrix[6].low		= (setTime.year << 4) & 0xF0;
-				actualMatrix[7].high	= (setTime.weekday >> 4) & 0x0F;
-				actualMatrix[7].low		= (setTime.weekday << 4) & 0xF0;
-				actualMatrix[8].high	= 0;
-				actualMatrix[8].low		= 0;
-				actualMatrix[9].high	= 0x50;
-				actualMatrix[9].low		= 0x20;
-				actualMatrix[10].high	= 0x21;
-				actualMatrix[10].low	= 0x40;
-				actualMatrix[11].high	= 0x50;
-				actualMatrix[11].low	= 0x80;
-			}
-			else
-			{
-				// display a time to set with ok
-				actualMatrix[0].high	= (setTime.hour >> 4) & 0x0F;
-				actualMatrix[0].low		= (setTime.hour << 4) & 0xF0;
-				actualMatrix[1].high	= (setTime.minute >> 4) & 0x0F;
-				actualMatrix[1].low		= (setTime.minute << 4) & 0xF0;
-				actualMatrix[2].high	= (setTime.second >> 4) & 0x0F;
-				actualMatrix[2].low		= (setTime.second << 4) & 0xF0;
-				actualMatrix[3].high	= 0;
-				actualMatrix[3].low		= 0;
-				actualMatrix[4].high	= (setTime.day >> 4) & 0x0F;
-				actualMatrix[4].low		= (setTime.day << 4) & 0xF0;
-				actualMatrix[5].high	= (setTime.month >> 4) & 0x0F;
-				actualMatrix[5].low		= (setTime.month << 4) & 0xF0;
-				actualMatrix[6].high	= (setTime.year >> 4) & 0x0F;
-				actualMatrix[6].low		= (setTime.year << 4) & 0xF0;
-				actualMatrix[7].high	= (setTime.weekday >> 4) & 0x0F;
-				actualMatrix[7].low		= (setTime.weekday << 4) & 0xF0;
-				actualMatrix[8].high	= 0;
-				actualMatrix[8].low		= 0;
-				actualMatrix[9].high	= 0x00;
-				actualMatrix[9].low		= 0x20;
-				actualMatrix[10].high	= 0x01;
-				actualMatrix[10].low	= 0x40;
-				actualMatrix[11].high	= 0x00;
-				actualMatrix[11].low	= 0x80;
-			}
-			break;
-		}
+		PT_SLEEP_MS(&pt, MENU_BLINK_TIME);
+	}
+	
+	PT_END(&pt);
+}
 
-		// set manual time - ok blinking
-		case DISPLAY_STATE_MENU_SET_OK:
+// actualize 'actualMatrix' Register with in menu mode
+// the screen of the menu state is described in 'menuScreens' (labels, icon and content)
+void actualizeMatrixInMenuMode(void)
+{
+	uint8_t i = 0;
+	uint8_t top = 0;
+	uint8_t bottom = 0;
+	uint8_t icon = 0;
+	uint8_t content = 0;
+	uint8_t mark = 0;
+	
+	// search screen of actual display status
+	for(i = 0; i < MENU_SCREENS; i++)
+	{
+		if(pgm_read_byte(&menuScreens[i].state) == systemConfig.displayStatus)
 		{
-			if (toggleFlag == 0)
-			{
-				// display a time to set with ok and cancel
-				actualMatrix[0].high	= (setTime.hour >> 4) & 0x0F;
-				actualMatrix[0].low		= (setTime.hour << 4) & 0xF0;
-				actualMatrix[1].high	= (setTime.minute >> 4) & 0x0F;
-				actualMatrix[1].low		= (setTime.minute << 4) & 0xF0;
-				actualMatrix[2].high	= (setTime.second >> 4) & 0x0F;
-				actualMatrix[2].low		= (setTime.second << 4) & 0xF0;
-				actualMatrix[3].high	= 0;
-				actualMatrix[3].low		= 0;
-				actualMatrix[4].high	= (setTime.day >> 4) & 0x0F;
-				actualMatrix[4].low		= (setTime.day << 4) & 0xF0;
-				actualMatrix[5].high	= (setTime.month >> 4) & 0x0F;
-				actualMatrix[5].low		= (setTime.month << 4) & 0xF0;
-				actualMatrix[6].high	= (setTime.year >> 4) & 0x0F;
-				actualMatrix[6].low		= (setTime.year << 4) & 0xF0;
-				actualMatrix[7].high	= (setTime.weekday >> 4) & 0x0F;
-				actualMatrix[7].low		= (setTime.weekday << 4) & 0xF0;
-				actualMatrix[8].high	= 0;
-				actualMatrix[8].low		= 0;
-				actualMatrix[9].high	= 0x50;
-				actualMatrix[9].low		= 0x20;
-				actualMatrix[10].high	= 0x21;
-				actualMatrix[10].low	= 0x40;
-				actualMatrix[11].high	= 0x50;
-				actualMatrix[11].low	= 0x80;
-			}
-			else
-			{
-				// display a time to set with cancel
-				actualMatrix[0].high	= (setTime.hour >> 4) & 0x0F;
-				actualMatrix[0].low		= (setTime.hour << 4) & 0xF0;
-				actualMatrix[1].high	= (setTime.minute >> 4) & 0x0F;
-				actualMatrix[1].low		= (setTime.minute << 4) & 0xF0;
-				actualMatrix[2].high	= (setTime.second >> 4) & 0x0F;
-				actualMatrix[2].low		= (setTime.second << 4) & 0xF0;
-				actualMatrix[3].high	= 0;
-				actualMatrix[3].low		= 0;
-				actualMatrix[4].high	= (setTime.day >> 4) & 0x0F;
-				actualMatrix[4].low		= (setTime.day << 4) & 0xF0;
-				actualMatrix[5].high	= (setTime.month >> 4) & 0x0F;
-				actualMatrix[5].low		= (setTime.month << 4) & 0xF0;
-				actualMatrix[6].high	= (setTime.year >> 4) & 0x0F;
-				actualMatrix[6].low		= (setTime.year << 4) & 0xF0;
-				actualMatrix[7].high	= (setTime.weekday >> 4) & 0x0F;
-				actualMatrix[7].low		= (setTime.weekday << 4) & 0xF0;
-				actualMatrix[8].high	= 0;
-				actualMatrix[8].low		= 0;
-				actualMatrix[9].high	= 0x50;
-				actualMatrix[9].low		= 0x00;
-				actualMatrix[10].high	= 0x20;
-				actualMatrix[10].low	= 0x00;
-				actualMatrix[11].high	= 0x50;
-				actualMatrix[11].low	= 0x00;
-			}
 			break;
 		}
+	}
+	// all other states: do nothing
+	if(i >= MENU_SCREENS)
+	{
+		return;
+	}
 	
-		// display settings
-		case DISPLAY_STATE_MENU_SETTINGS:
+	// toggle flag is changed by menu blink thread
+	top = pgm_read_byte(&menuScreens[i].top);
+	bottom = pgm_read_byte(&menuScreens[i].bottom);
+	if (toggleFlag == 0)
+	{
+		icon = pgm_read_byte(&menuScreens[i].icon);
+		mark = MENU_MARK_NONE;
+	}
+	else
+	{
+		icon = pgm_read_byte(&menuScreens[i].blink);
+		mark = pgm_read_byte(&menuScreens[i].mark);
+	}
+	content = pgm_read_byte(&menuScreens[i].content);
+	
+	// icon in row 6 to 11, all other rows are cleared
+	for(i = 0; i < 6; i++)
+	{
+		actualMatrix[i].high		= 0x00;
+		actualMatrix[i].low			= 0x00;
+		actualMatrix[i + 6].high	= pgm_read_byte(&menuIcons[icon][i].high);
+		actualMatrix[i + 6].low		= pgm_read_byte(&menuIcons[icon][i].low);
+	}
+	
+	// labels in row 0 and row 6
+	drawMatrixText(0, pgm_read_byte(&menuLabels[top].column), menuLabels[top].text);
+	drawMatrixText(6, pgm_read_byte(&menuLabels[bottom].column), menuLabels[bottom].text);
+	
+	// dynamic content
+	switch(content)
+	{
+		// time to set with ok and cancel
+		case MENU_CONTENT_SET_TIME:
 		{
-			// display SET
-			actualMatrix[0].high	= 0xEE;
-			actualMatrix[0].low		= 0xE0;
-			actualMatrix[1].high	= 0x88;
-			actualMatrix[1].low		= 0x40;
-			actualMatrix[2].high	= 0xEC;
-			actualMatrix[2].low		= 0x40;
-			actualMatrix[3].high	= 0x28;
-			actualMatrix[3].low		= 0x40;
-			actualMatrix[4].high	= 0xEE;
-			actualMatrix[4].low		= 0x40;
-			actualMatrix[5].high	= 0;
-			actualMatrix[5].low		= 0;
-			actualMatrix[6].high	= 0;
-			actualMatrix[6].low		= 0;
-			actualMatrix[7].high	= 0;
-			actualMatrix[7].low		= 0;
-			actualMatrix[8].high	= 0;
-			actualMatrix[8].low		= 0;
-			actualMatrix[9].high	= 0;
-			actualMatrix[9].low		= 0;
-			actualMatrix[10].high	= 0;
-			actualMatrix[10].low	= 0;
-			actualMatrix[11].high	= 0;
-			actualMatrix[11].low	= 0;
+			addMatrixRowValue(0, setTime.hour);
+			addMatrixRowValue(1, setTime.minute);
+			addMatrixRowValue(2, setTime.second);
+			addMatrixRowValue(4, setTime.day);
+			addMatrixRowValue(5, setTime.month);
+			addMatrixRowValue(6, setTime.year);
+			addMatrixRowValue(7, setTime.weekday);
 			break;
 		}
 		
-		// display settings: brightness
-		case DISPLAY_STATE_MENU_BRIGTHNESS:
+		// manual display brightness (decimal, 0 to 255)
+		case MENU_CONTENT_BRIGHTNESS:
 		{
-			// display BRI
-			actualMatrix[0].high	= 0xCC;
-			actualMatrix[0].low		= 0x80;
-			actualMatrix[1].high	= 0xAA;
-			actualMatrix[1].low		= 0x80;
-			actualMatrix[2].high	= 0xCC;
-			actualMatrix[2].low		= 0x80;
-			actualMatrix[3].high	= 0xAA;
-			actualMatrix[3].low		= 0x80;
-			actualMatrix[4].high	= 0xCA;
-			actualMatrix[4].low		= 0x80;
-			actualMatrix[5].high	= 0;
-			actualMatrix[5].low		= 0;
-			actualMatrix[6].high	= 0;
-			actualMatrix[6].low		= 0;
-			actualMatrix[7].high	= 0;
-			actualMatrix[7].low		= 0;
-			actualMatrix[8].high	= 0;
-			actualMatrix[8].low		= 0;
-			actualMatrix[9].high	= 0;
-			actualMatrix[9].low		= 0;
-			actualMatrix[10].high	= 0;
-			actualMatrix[10].low	= 0;
-			actualMatrix[11].high	= 0;
-			actualMatrix[11].low	= 0;
+			drawMatrixNumber(6, 0, systemConfig.manualBrightness, 3);
 			break;
-		}	
-		
-			// display settings: brightness - automatic mode
-			case DISPLAY_STATE_MENU_BRIGHT_AUTO:
-			{
-				// display BRI lbr AUT
-				actualMatrix[0].high	= 0xCC;
-				actualMatrix[0].low		= 0x80;
-				actualMatrix[1].high	= 0xAA;
-				actualMatrix[1].low		= 0x80;
-				actualMatrix[2].high	= 0xCC;
-				actualMatrix[2].low		= 0x80;
-				actualMatrix[3].high	= 0xAA;
-				actualMatrix[3].low		= 0x80;
-				actualMatrix[4].high	= 0xCA;
-				actualMatrix[4].low		= 0x80;
-				actualMatrix[5].high	= 0;
-				actualMatrix[5].low		= 0;
-				actualMatrix[6].high	= 0x4A;
-				actualMatrix[6].low		= 0xE0;
-				actualMatrix[7].high	= 0xAA;
-				actualMatrix[7].low		= 0x40;
-				actualMatrix[8].high	= 0xEA;
-				actualMatrix[8].low		= 0x40;
-				actualMatrix[9].high	= 0xAA;
-				actualMatrix[9].low		= 0x40;
-				actualMatrix[10].high	= 0xAE;
-				actualMatrix[10].low	= 0x50;
-				actualMatrix[11].high	= 0x00;
-				actualMatrix[11].low	= 0x00;
-				break;
-			}		
-		
-			// display settings: brightness - manual mode
-			case DISPLAY_STATE_MENU_BRIGHT_MANU:
-			{
-				// display BRI lbr MAN
-				actualMatrix[0].high	= 0xCC;
-				actualMatrix[0].low		= 0x80;
-				actualMatrix[1].high	= 0xAA;
-				actualMatrix[1].low		= 0x80;
-				actualMatrix[2].high	= 0xCC;
-				actualMatrix[2].low		= 0x80;
-				actualMatrix[3].high	= 0xAA;
-				actualMatrix[3].low		= 0x80;
-				actualMatrix[4].high	= 0xCA;
-				actualMatrix[4].low		= 0x80;
-				actualMatrix[5].high	= 0;
-				actualMatrix[5].low		= 0;
-				actualMatrix[6].high	= 0xA4;
-				actualMatrix[6].low		= 0x90;
-				actualMatrix[7].high	= 0xEA;
-				actualMatrix[7].low		= 0xC0;
-				actualMatrix[8].high	= 0xAE;
-				actualMatrix[8].low		= 0x90;
-				actualMatrix[9].high	= 0xAA;
-				actualMatrix[9].low		= 0xB0;
-				actualMatrix[10].high	= 0xAA;
-				actualMatrix[10].low	= 0x90;
-				actualMatrix[11].high	= 0x00;
-				actualMatrix[11].low	= 0x00;
-				break;
-			}		
+		}
 		
-		// display settings: pie 
-		case DISPLAY_STATE_MENU_PIE:
+		// shift of pie in minutes (decimal, one digit)
+		case MENU_CONTENT_PIE_SHIFT:
 		{
-			// display PIE
-			actualMatrix[0].high	= 0xCB;
-			actualMatrix[0].low		= 0x80;
-			actualMatrix[1].high	= 0xAA;
-			actualMatrix[1].low		= 0x00;
-			actualMatrix[2].high	= 0xCB;
-			actualMatrix[2].low		= 0x00;
-			actualMatrix[3].high	= 0x8A;
-			actualMatrix[3].low		= 0x00;
-			actualMatrix[4].high	= 0x8B;
-			actualMatrix[4].low		= 0x80;
-			actualMatrix[5].high	= 0;
-			actualMatrix[5].low		= 0;
-			actualMatrix[6].high	= 0;
-			actualMatrix[6].low		= 0;
-			actualMatrix[7].high	= 0;
-			actualMatrix[7].low		= 0;
-			actualMatrix[8].high	= 0;
-			actualMatrix[8].low		= 0;
-			actualMatrix[9].high	= 0;
-			actualMatrix[9].low		= 0;
-			actualMatrix[10].high	= 0;
-			actualMatrix[10].low	= 0;
-			actualMatrix[11].high	= 0;
-			actualMatrix[11].low	= 0;
+			drawMatrixNumber(6, 4, systemConfig.pieShift, 1);
 			break;
 		}
-
-			// display settings: pie straight
-			case DISPLAY_STATE_MENU_PIE_STRAIGHT:
-			{
-				// display PIE lbr I
-				actualMatrix[0].high	= 0xCB;
-				actualMatrix[0].low		= 0x80;
-				actualMatrix[1].high	= 0xAA;
-				actualMatrix[1].low		= 0x00;
-				actualMatrix[2].high	= 0xCB;
-				actualMatrix[2].low		= 0x00;
-				actualMatrix[3].high	= 0x8A;
-				actualMatrix[3].low		= 0x00;
-				actualMatrix[4].high	= 0x8B;
-				actualMatrix[4].low		= 0x80;
-				actualMatrix[5].high	= 0;
-				actualMatrix[5].low		= 0;
-				actualMatrix[6].high	= 0x02;
-				actualMatrix[6].low		= 0;
-				actualMatrix[7].high	= 0x02;
-				actualMatrix[7].low		= 0;
-				actualMatrix[8].high	= 0x02;
-				actualMatrix[8].low		= 0;
-				actualMatrix[9].high	= 0x02;
-				actualMatrix[9].low		= 0;
-				actualMatrix[10].high	= 0x02;
-				actualMatrix[10].low	= 0;
-				actualMatrix[11].high	= 0;
-				actualMatrix[11].low	= 0;
-				break;
-			}		
-			
-			// display settings: pie shift
-			case DISPLAY_STATE_MENU_PIE_SHIFT:
-			{
-				// display PIE lbr V
-				actualMatrix[0].high	= 0xCB;
-				actualMatrix[0].low		= 0x80;
-				actualMatrix[1].high	= 0xAA;
-				actualMatrix[1].low		= 0x00;
-				actualMatrix[2].high	= 0xCB;
-				actualMatrix[2].low		= 0x00;
-				actualMatrix[3].high	= 0x8A;
-				actualMatrix[3].low		= 0x00;
-				actualMatrix[4].high	= 0x8B;
-				actualMatrix[4].low		= 0x80;
-				actualMatrix[5].high	= 0;
-				actualMatrix[5].low		= 0;
-				actualMatrix[6].high	= 0x20;
-				actualMatrix[6].low		= 0x20;
-				actualMatrix[7].high	= 0x10;
-				actualMatrix[7].low		= 0x40;
-				actualMatrix[8].high	= 0x08;
-				actualMatrix[8].low		= 0x80;
-				actualMatrix[9].high	= 0x05;
-				actualMatrix[9].low		= 0x00;
-				actualMatrix[10].high	= 0x02;
-				actualMatrix[10].low	= 0x00;
-				actualMatrix[11].high	= 0;
-				actualMatrix[11].low	= 0;
-				break;
-			}			
-					
-		// display settings: character variant
-		case DISPLAY_STATE_MENU_CHAR:
-		{
-			// display CHA
-			actualMatrix[0].high	= 0x6A;
-			actualMatrix[0].low		= 0x40;
-			actualMatrix[1].high	= 0x8A;
-			actualMatrix[1].low		= 0xA0;
-			actualMatrix[2].high	= 0x8E;
-			actualMatrix[2].low		= 0xE0;
-			actualMatrix[3].high	= 0x8A;
-			actualMatrix[3].low		= 0xA0;
-			actualMatrix[4].high	= 0x6A;
-			actualMatrix[4].low		= 0xA0;
-			actualMatrix[5].high	= 0;
-			actualMatrix[5].low		= 0;
-			actualMatrix[6].high	= 0;
-			actualMatrix[6].low		= 0;
-			actualMatrix[7].high	= 0;
-			actualMatrix[7].low		= 0;
-			actualMatrix[8].high	= 0;
-			actualMatrix[8].low		= 0;
-			actualMatrix[9].high	= 0;
-			actualMatrix[9].low		= 0;
-			actualMatrix[10].high	= 0;
-			actualMatrix[10].low	= 0;
-			actualMatrix[11].high	= 0;
-			actualMatrix[11].low	= 0;
-			break;
-		}	
 		
-			// display settings: character variant standard
-			case DISPLAY_STATE_MENU_CHAR_STANDARD:
-			{
-				// display CHA lbr STD
-				actualMatrix[0].high	= 0x6A;
-				actualMatrix[0].low		= 0x40;
-				actualMatrix[1].high	= 0x8A;
-				actualMatrix[1].low		= 0xA0;
-				actualMatrix[2].high	= 0x8E;
-				actualMatrix[2].low		= 0xE0;
-				actualMatrix[3].high	= 0x8A;
-				actualMatrix[3].low		= 0xA0;
-				actualMatrix[4].high	= 0x6A;
-				actualMatrix[4].low		= 0xA0;
-				actualMatrix[5].high	= 0;
-				actualMatrix[5].low		= 0;
-				actualMatrix[6].high	= 0xEE;
-				actualMatrix[6].low		= 0xC0;
-				actualMatrix[7].high	= 0x84;
-				actualMatrix[7].low		= 0xA0;
-				actualMatrix[8].high	= 0xE4;
-				actualMatrix[8].low		= 0xA0;
-				actualMatrix[9].high	= 0x24;
-				actualMatrix[9].low		= 0xA0;
-				actualMatrix[10].high	= 0xE4;
-				actualMatrix[10].low	= 0xC0;
-				actualMatrix[11].high	= 0;
-				actualMatrix[11].low	= 0;
-				break;
-			}
-
-			// display settings: character variant birthday & horses
-			case DISPLAY_STATE_MENU_CHAR_BIRTHDAY:
-			{
-				// display CHA lbr HOR
-				actualMatrix[0].high	= 0x6A;
-				actualMatrix[0].low		= 0x40;
-				actualMatrix[1].high	= 0x8A;
-				actualMatrix[1].low		= 0xA0;
-				actualMatrix[2].high	= 0x8E;
-				actualMatrix[2].low		= 0xE0;
-				actualMatrix[3].high	= 0x8A;
-				actualMatrix[3].low		= 0xA0;
-				actualMatrix[4].high	= 0x6A;
-				actualMatrix[4].low		= 0xA0;
-				actualMatrix[5].high	= 0;
-				actualMatrix[5].low		= 0;
-				actualMatrix[6].high	= 0xAE;
-				actualMatrix[6].low		= 0xC0;
-				actualMatrix[7].high	= 0xAA;
-				actualMatrix[7].low		= 0xA0;
-				actualMatrix[8].high	= 0xEA;
-				actualMatrix[8].low		= 0xC0;
-				actualMatrix[9].high	= 0xAA;
-				actualMatrix[9].low		= 0xA0;
-				actualMatrix[10].high	= 0xAE;
-				actualMatrix[10].low	= 0xA0;
-				actualMatrix[11].high	= 0;
-				actualMatrix[11].low	= 0;
-				break;
-			}	
-		
-		// display settings: searching sequence
-		case DISPLAY_STATE_MENU_SEARCH_MODE:
+		// software system version (decimal)
+		case MENU_CONTENT_VERSION:
 		{
-			// display char SER
-			actualMatrix[0].high	= 0xEE;
-			actualMatrix[0].low		= 0xC0;
-			actualMatrix[1].high	= 0x88;
-			actualMatrix[1].low		= 0xA0;
-			actualMatrix[2].high	= 0xEC;
-			actualMatrix[2].low		= 0xC0;
-			actualMatrix[3].high	= 0x28;
-			actualMatrix[3].low		= 0xA0;
-			actualMatrix[4].high	= 0xEE;
-			actualMatrix[4].low		= 0xA0;
-			actualMatrix[5].high	= 0;
-			actualMatrix[5].low		= 0;
-			actualMatrix[6].high	= 0;
-			actualMatrix[6].low		= 0;
-			actualMatrix[7].high	= 0;
-			actualMatrix[7].low		= 0;
-			actualMatrix[8].high	= 0;
-			actualMatrix[8].low		= 0;
-			actualMatrix[9].high	= 0;
-			actualMatrix[9].low		= 0;
-			actualMatrix[10].high	= 0;
-			actualMatrix[10].low	= 0;
-			actualMatrix[11].high	= 0;
-			actualMatrix[11].low	= 0;
+			drawMatrixNumber(6, 0, systemConfig.version, 3);
 			break;
-		}		
-
-			// display settings: searching sequence square
-			case DISPLAY_STATE_MENU_SEARCH_SQUARE:
-			{
-				// display char SER lbr SQU
-				actualMatrix[0].high	= 0xEE;
-				actualMatrix[0].low		= 0xC0;
-				actualMatrix[1].high	= 0x88;
-				actualMatrix[1].low		= 0xA0;
-				actualMatrix[2].high	= 0xEC;
-				actualMatrix[2].low		= 0xC0;
-				actualMatrix[3].high	= 0x28;
-				actualMatrix[3].low		= 0xA0;
-				actualMatrix[4].high	= 0xEE;
-				actualMatrix[4].low		= 0xA0;
-				actualMatrix[5].high	= 0;
-				actualMatrix[5].low		= 0;
-				actualMatrix[6].high	= 0xEE;
-				actualMatrix[6].low		= 0x50;
-				actualMatrix[7].high	= 0x8A;
-				actualMatrix[7].low		= 0x50;
-				actualMatrix[8].high	= 0xEA;
-				actualMatrix[8].low		= 0x50;
-				actualMatrix[9].high	= 0x2A;
-				actualMatrix[9].low		= 0x50;
-				actualMatrix[10].high	= 0xEF;
-				actualMatrix[10].low	= 0x70;
-				actualMatrix[11].high	= 0;
-				actualMatrix[11].low	= 0;
-				break;
-			}
-			
-			// display settings: no searching sequence
-			case DISPLAY_STATE_MENU_SEARCH_NO:
-			{
-				// display char SER lbr NO
-				actualMatrix[0].high	= 0xEE;
-				actualMatrix[0].low		= 0xC0;
-				actualMatrix[1].high	= 0x88;
-				actualMatrix[1].low		= 0xA0;
-				actualMatrix[2].high	= 0xEC;
-				actualMatrix[2].low		= 0xC0;
-				actualMatrix[3].high	= 0x28;
-				actualMatrix[3].low		= 0xA0;
-				actualMatrix[4].high	= 0xEE;
-				actualMatrix[4].low		= 0xA0;
-				actualMatrix[5].high	= 0;
-				actualMatrix[5].low		= 0;
-				actualMatrix[6].high	= 0x8B;
-				actualMatrix[6].low		= 0x80;
-				actualMatrix[7].high	= 0xCA;
-				actualMatrix[7].low		= 0x80;
-				actualMatrix[8].high	= 0xAA;
-				actualMatrix[8].low		= 0x80;
-				actualMatrix[9].high	= 0x9A;
-				actualMatrix[9].low		= 0x80;
-				actualMatrix[10].high	= 0x8B;
-				actualMatrix[10].low	= 0x80;
-				actualMatrix[11].high	= 0;
-				actualMatrix[11].low	= 0;
-				break;
-			}			
-			
-		// debug mode
-		case DISPLAY_STATE_MENU_DBG:
-		{
-			// display DBG
-			actualMatrix[0].high	= 0xCE;
-			actualMatrix[0].low		= 0xE0;
-			actualMatrix[1].high	= 0xAA;
-			actualMatrix[1].low		= 0x80;
-			actualMatrix[2].high	= 0xAC;
-			actualMatrix[2].low		= 0xB0;
-			actualMatrix[3].high	= 0xAA;
-			actualMatrix[3].low		= 0x90;
-			actualMatrix[4].high	= 0xCE;
-			actualMatrix[4].low		= 0xF0;
-			actualMatrix[5].high	= 0;
-			actualMatrix[5].low		= 0;
-			actualMatrix[6].high	= 0;
-			actualMatrix[6].low		= 0;
-			actualMatrix[7].high	= 0;
-			actualMatrix[7].low		= 0;
-			actualMatrix[8].high	= 0;
-			actualMatrix[8].low		= 0;
-			actualMatrix[9].high	= 0;
-			actualMatrix[9].low		= 0;
-			actualMatrix[10].high	= 0;
-			actualMatrix[10].low	= 0;
-			actualMatrix[11].high	= 0;
-			actualMatrix[11].low	= 0;
-			break;		
 		}
 		
 		// debug mode 1
-		case DISPLAY_STATE_MENU_DBG1:
+		case MENU_CONTENT_DBG1:
 		{
-			// display DBG
-			actualMatrix[0].high	= 0xCE;
-			actualMatrix[0].low		= 0xE0;
-			actualMatrix[1].high	= 0xAA;
-			actualMatrix[1].low		= 0x80;
-			actualMatrix[2].high	= 0xAC;
-			actualMatrix[2].low		= 0xB0;
-			actualMatrix[3].high	= 0xAA;
-			actualMatrix[3].low		= 0x90;
-			actualMatrix[4].high	= 0xCE;
-			actualMatrix[4].low		= 0xF0;
-			actualMatrix[5].high	= 0;
-			actualMatrix[5].low		= 0;
 			// see status description in system.h
 			actualMatrix[6].high	= systemConfig.status;
-			actualMatrix[6].low		= 0;
 			// see display settings description in system.h
 			actualMatrix[7].high	= systemConfig.displaySetting;
-			actualMatrix[7].low		= 0;
-			actualMatrix[8].high	= 0;
-			actualMatrix[8].low		= 0;
-			actualMatrix[9].high	= 0;
-			actualMatrix[9].low		= 0;
-			actualMatrix[10].high	= 0;
-			actualMatrix[10].low	= 0;
+#ifdef TASK_PROFILING
+			// run time of selected task: minimum, maximum and mean (4us ticks)
+			setMatrixRowValue(8, getProfileValue(getProfileSelection(), PROFILE_RUN_MIN));
+			setMatrixRowValue(9, getProfileValue(getProfileSelection(), PROFILE_RUN_MAX));
+			setMatrixRowValue(10, getProfileValue(getProfileSelection(), PROFILE_RUN_MEAN));
+			// software system version and selected task
+			actualMatrix[11].high	= systemConfig.version;
+			actualMatrix[11].low	= getProfileSelection() << 4;
+#else
 			// software system version
 			actualMatrix[11].high	= systemConfig.version;
-			actualMatrix[11].low	= 0;
+#endif
 			break;
 		}
 		
 		// debug mode 2
-		case DISPLAY_STATE_MENU_DBG2:
+		case MENU_CONTENT_DBG2:
 		{
-			// display DBG
-			actualMatrix[0].high	= 0xCE;
-			actualMatrix[0].low		= 0xE0;
-			actualMatrix[1].high	= 0xAA;
-			actualMatrix[1].low		= 0x80;
-			actualMatrix[2].high	= 0xAC;
-			actualMatrix[2].low		= 0xB0;
-			actualMatrix[3].high	= 0xAA;
-			actualMatrix[3].low		= 0x90;
-			actualMatrix[4].high	= 0xCE;
-			actualMatrix[4].low		= 0xF0;
-			actualMatrix[5].high	= 0;
-			actualMatrix[5].low		= 0;
 			// light intensity of measured value (range is 0 dark to 255 bright);
 			actualMatrix[6].high	= systemConfig.lightIntensity;
-			actualMatrix[6].low		= 0;
 			// set value of potentiometer (range is 0 low to 255 high)
 			actualMatrix[7].high	= systemConfig.potentiometerValue;
-			actualMatrix[7].low		= 0;
 			// display brightness (range 0 dark to 255 bright)
 			actualMatrix[8].high	= systemConfig.displayBrightness;
-			actualMatrix[8].low		= 0;
-			actualMatrix[9].high	= 0;
-			actualMatrix[9].low		= 0;
-			actualMatrix[10].high	= 0;
-			actualMatrix[10].low	= 0;
-			actualMatrix[11].high	= 0;
-			actualMatrix[11].low	= 0;
+			// dropped events of event queue
+			actualMatrix[9].high	= getDroppedEvents();
+#ifdef TASK_PROFILING
+			// overruns of selected task (saturated to 4 bits)
+			if(getProfileValue(getProfileSelection(), PROFILE_OVERRUNS) < 15)
+			{
+				actualMatrix[9].low	= getProfileValue(getProfileSelection(), PROFILE_OVERRUNS) << 4;
+			}
+			else
+			{
+				actualMatrix[9].low	= 0xF0;
+			}
+			// latency of selected task: maximum and mean (4us ticks)
+			setMatrixRowValue(10, getProfileValue(getProfileSelection(), PROFILE_LATENCY_MAX));
+			setMatrixRowValue(11, getProfileValue(getProfileSelection(), PROFILE_LATENCY_MEAN));
+#endif
 			break;
 		}
 		
 		// debug mode 3
-		case DISPLAY_STATE_MENU_DBG3:
+		case MENU_CONTENT_DBG3:
+		{
+			// actual system time
+			addMatrixRowValue(5, systemTime.hour);
+			addMatrixRowValue(6, systemTime.minute);
+			addMatrixRowValue(7, systemTime.second);
+			addMatrixRowValue(8, systemTime.day);
+			addMatrixRowValue(9, systemTime.month);
+			addMatrixRowValue(10, systemTime.year);
+			addMatrixRowValue(11, systemTime.weekday);
+			break;
+		}
+		
+		// debug mode 4
+		case MENU_CONTENT_DBG4:
 		{
-			// display DBG
-			actualMatrix[0].high	= 0xCE;
-			actualMatrix[0].low		= 0xE0;
-			actualMatrix[1].high	= 0xAA;
-			actualMatrix[1].low		= 0x80;
-			actualMatrix[2].high	= 0xAC;
-			actualMatrix[2].low		= 0xB0;
-			actualMatrix[3].high	= 0xAA;
-			actualMatrix[3].low		= 0x90;
-			actualMatrix[4].high	= 0xCE;
-			actualMatrix[4].low		= 0xF0;
-			actualMatrix[5].high	= (systemTime.hour >> 4) & 0x0F;
-			actualMatrix[5].low		= (systemTime.hour << 4) & 0xF0;
-			actualMatrix[6].high	= (systemTime.minute >> 4) & 0x0F;
-			actualMatrix[6].low		= (systemTime.minute << 4) & 0xF0;			
-			actualMatrix[7].high	= (systemTime.second >> 4) & 0x0F;
-			actualMatrix[7].low		= (systemTime.second << 4) & 0xF0;
-			actualMatrix[8].high	= (systemTime.day >> 4) & 0x0F;
-			actualMatrix[8].low		= (systemTime.day << 4) & 0xF0;
-			actualMatrix[9].high	= (systemTime.month >> 4) & 0x0F;
-			actualMatrix[9].low		= (systemTime.month << 4) & 0xF0;
-			actualMatrix[10].high	= (systemTime.year >> 4) & 0x0F;
-			actualMatrix[10].low	= (systemTime.year << 4) & 0xF0;
-			actualMatrix[11].high	= (systemTime.weekday >> 4) & 0x0F;
-			actualMatrix[11].low	= (systemTime.weekday << 4) & 0xF0;
+			// stack pointer of last watchdog reset (lower 12 bits)
+			setMatrixRowValue(5, getSupervisorResetStack() & 0x0FFF);
+			// reset flags of last reset (see MCUSR)
+			actualMatrix[6].high	= getResetFlags();
+			// number of watchdog resets since power on
+			actualMatrix[7].high	= getSupervisorResets();
+			// task of last watchdog reset (bit 7: deadline missed)
+			actualMatrix[8].high	= getSupervisorResetTask();
+			// lowest and actual supply voltage (10mV steps)
+			setMatrixRowValue(9, getSupplyMinimum() / 10);
+			setMatrixRowValue(10, getSupplyVoltage() / 10);
+			// drops of supply voltage
+			actualMatrix[11].high	= getSupplyLowEvents();
 			break;
 		}
 		
-		// default all other states
+		// static screen
 		default:
 		{
-			// do nothing
 			break;
 		}
 	}
+	
+	// blinking mark of edited value
+	if(mark != MENU_MARK_NONE)
+	{
+		actualMatrix[mark].high |= 0x80;
+	}
 }
\ No newline at end of file
@@ -24,6 +24,25 @@ struct row
 	uint8_t low;	// information from 9th to 12th led last 4 bits are empty
 };
 
+//! label of a menu screen, drawn with the 3x5 font (see menuLabels in ledMatrix.c)
+struct menuLabel
+{
+	uint8_t column;		// first column of text
+	char text[5];		// text (upper case, null terminated)
+};
+
+//! screen of a menu state (see menuScreens in ledMatrix.c)
+struct menuScreen
+{
+	uint8_t state;		// display status of menu
+	uint8_t top;		// label in row 0 to 4
+	uint8_t bottom;		// label in row 6 to 10
+	uint8_t icon;		// icon in row 6 to 11
+	uint8_t blink;		// icon in row 6 to 11 while blinking
+	uint8_t content;	// dynamic content (values, debug information)
+	uint8_t mark;		// row of blinking mark (edited value)
+};
+
 //! Functional prototypes
 void initMatrix(void);
 void sendMatrixToShiftRegister(uint8_t row);
@@ -31,10 +50,73 @@ void resetMatrixShiftRegister(void);
 void loadMatrixShiftRegister(void);
 void enableMatrix(void);
 void disableMatrix(void);
+void stopMatrix(void);
+void startMatrix(void);
+void setMatrixFrameSkip(uint8_t frames);
 void setMatrixDark(void);
 void setMatrixBright(void);
+void setMatrixRowValue(uint8_t row, uint16_t value);
+void addMatrixRowValue(uint8_t row, uint8_t value);
+void setMatrixLedLimit(uint8_t limit);
+uint8_t countMatrixLeds(uint8_t value);
+void calculateRowDuty(uint8_t pwmValue);
+uint16_t getMatrixCurrent(void);
 // upper layer functions
 void actualizeMatrixWithSystemTime(void);
-void actualizeMatrixWithSearchingSequence(void);
+void actualizeMatrixWithTimeNumber(void);
+void actualizeMatrixWithDateNumber(void);
+void setMatrixSquare(uint8_t ring);
 void actualizeMatrixInMenuMode(void);
+// threads
+uint8_t threadSearchingSequence(void);
+uint8_t threadMenuBlink(void);
+
+//! Menu screens
+#define MENU_SCREENS				37	// number of menu screens
+#define MENU_MARK_NONE				0xFF	// no blinking mark
+
+//! Dynamic content of menu screens
+#define MENU_CONTENT_NONE			0	// static screen
+#define MENU_CONTENT_SET_TIME		1	// time to set (setTime)
+#define MENU_CONTENT_BRIGHTNESS		2	// manual display brightness
+#define MENU_CONTENT_PIE_SHIFT		3	// shift of pie in minutes
+#define MENU_CONTENT_DBG1			4	// debug mode 1 (status, profiler)
+#define MENU_CONTENT_DBG2			5	// debug mode 2 (brightness, profiler)
+#define MENU_CONTENT_DBG3			6	// debug mode 3 (system time)
+#define MENU_CONTENT_DBG4			7	// debug mode 4 (reset, supply voltage)
+#define MENU_CONTENT_VERSION		8	// software system version
+
+//! Labels of menu screens (see menuLabels in ledMatrix.c)
+#define MENU_LABEL_EMPTY			0
+#define MENU_LABEL_VER				1
+#define MENU_LABEL_TIME				2
+#define MENU_LABEL_AUT				3
+#define MENU_LABEL_MAN				4
+#define MENU_LABEL_SET				5
+#define MENU_LABEL_BRI				6
+#define MENU_LABEL_PIE				7
+#define MENU_LABEL_CHA				8
+#define MENU_LABEL_SER				9
+#define MENU_LABEL_DBG				10
+#define MENU_LABEL_STD				11
+#define MENU_LABEL_HOR				12
+#define MENU_LABEL_SQU				13
+#define MENU_LABEL_NO				14
+#define MENU_LABEL_HOUR				15
+#define MENU_LABEL_MINUTE			16
+#define MENU_LABEL_SECOND			17
+#define MENU_LABEL_DAY				18
+#define MENU_LABEL_MONTH			19
+#define MENU_LABEL_YEAR				20
+#define MENU_LABEL_WEEKDAY			21
 
+//! Icons of menu screens (see menuIcons in ledMatrix.c)
+#define MENU_ICON_EMPTY				0
+#define MENU_ICON_CANCEL_OK			1
+#define MENU_ICON_OK				2
+#define MENU_ICON_CANCEL			3
+#define MENU_ICON_SET_CANCEL_OK		4
+#define MENU_ICON_SET_OK			5
+#define MENU_ICON_SET_CANCEL		6
+#define MENU_ICON_STRAIGHT			7
+#define MENU_ICON_SHIFT				8
\ No newline at end of file
@@ -0,0 +1,270 @@
+/*******************************************************************************
+*
+*	Author:			Georg Bauer
+*	Date:			18.10.2026
+*
+*	Project-Title:	ClockWise
+*	Description:	Event log as ring buffer in eeprom
+*
+*	File-Title:		Event Log
+*
+*******************************************************************************
+*
+* Events (reset causes, dcf77 sync, manual time, supply drops, rtc errors)
+* are logged as 8 byte entries (struct logEntry) to a ring buffer of
+* LOG_ENTRIES entries (eepromLog, placed by the linker). The sequence byte of the entries
+* is consecutive in ring order: at boot the first break of the sequence (or
+* the first empty entry) is the next write position.
+*
+* Batched writes: logEvent() (only called from main loop) collects entries in
+* a buffer of LOG_BUFFER_SIZE entries. threadLog() writes them, when
+* LOG_BATCH entries are waiting, LOG_FLUSH_TIME has passed or flushLog() is
+* called. Rejected dcf77 frames are counted in one waiting entry. Entries
+* on a full buffer are dropped and counted.
+*
+* Time: packed system time, bit 31..26 year, 25..22 month, 21..17 day,
+* 16..12 hour, 11..6 minute, 5..0 second (0: no time available). The year
+* (2000 + 0 to 63) wraps in 2064.
+*
+* Tools/logdecode.py decodes an eeprom image or the dump of the console
+* (command 'log', see console.c).
+*
+*******************************************************************************
+*/
+
+//! Libraries
+#include "log.h"
+#include "settings.h"
+#include "system.h"
+#include "protothread.h"
+#include "usart.h"
+
+//! Own global variables
+// ring buffer in eeprom
+struct logEntry eepromLog[LOG_ENTRIES] EEMEM;
+// entries waiting for write
+struct logEntry logBuffer[LOG_BUFFER_SIZE];
+uint8_t logWaiting;
+// next write position in eeprom and its sequence
+uint8_t logHead;
+uint8_t logSequence;
+// write of waiting entries is requested
+uint8_t logFlush;
+// an entry is written to eeprom
+uint8_t logWriting;
+// dropped entries on full buffer (saturated)
+uint8_t logDropped;
+
+//! Extern global variables
+extern volatile struct systemParameter systemConfig;
+extern volatile struct time systemTime;
+
+//! Search write position of ring buffer in eeprom
+void initLog(void)
+{
+	uint8_t i = 0;
+	uint8_t sequence = 0;
+	uint8_t lastSequence = 0;
+	uint8_t code = 0;
+	
+	logWaiting = 0;
+	logFlush = 0;
+	logWriting = 0;
+	logDropped = 0;
+	logHead = 0;
+	logSequence = 0;
+	
+	for(i = 0; i < LOG_ENTRIES; i++)
+	{
+		code = eeprom_read_byte(&eepromLog[i].code);
+		sequence = eeprom_read_byte(&eepromLog[i].sequence);
+		
+		// first empty entry or break of sequence: next write position
+		if((code == LOG_EVENT_NONE) || (i && (sequence != (uint8_t)(lastSequence + 1))))
+		{
+			logHead = i;
+			logSequence = lastSequence + 1;
+			// empty log starts with sequence 0
+			if(!i)
+			{
+				logSequence = 0;
+			}
+			return;
+		}
+		lastSequence = sequence;
+	}
+	
+	// no break: the oldest entry is the first one
+	logSequence = lastSequence + 1;
+}
+
+//! Log an event with packed system time, only called from main loop
+// input: event (see LOG_EVENT_*) and payload
+void logEvent(uint8_t code, uint16_t payload)
+{
+	uint8_t count = 1;
+	
+	// rejected dcf77 frames: count in last waiting entry
+	if((code == LOG_EVENT_DCF_FAIL) && logWaiting && (logBuffer[logWaiting - 1].code == LOG_EVENT_DCF_FAIL))
+	{
+		count = logBuffer[logWaiting - 1].payload >> 8;
+		if(count < 255)
+		{
+			count++;
+		}
+		logBuffer[logWaiting - 1].payload = ((uint16_t)count << 8) | (payload & 0x00FF);
+		logBuffer[logWaiting - 1].time = packLogTime();
+		return;
+	}
+	
+	// buffer full: drop event
+	if(logWaiting >= LOG_BUFFER_SIZE)
+	{
+		if(logDropped < 255)
+		{
+			logDropped++;
+		}
+		return;
+	}
+	
+	// first rejected dcf77 frame: count 1 and reason
+	if(code == LOG_EVENT_DCF_FAIL)
+	{
+		payload = ((uint16_t)count << 8) | (payload & 0x00FF);
+	}
+	logBuffer[logWaiting].code = code;
+	logBuffer[logWaiting].payload = payload;
+	logBuffer[logWaiting].time = packLogTime();
+	logWaiting++;
+}
+
+//! Request write of waiting entries (important events)
+void flushLog(void)
+{
+	logFlush = 1;
+}
+
+//! Pack system time into 32 bits, 0 if no time is available
+uint32_t packLogTime(void)
+{
+	uint32_t time = 0;
+	
+	// - xxxx.xxx1b time information in system available
+	if(!(systemConfig.status & 0x01))
+	{
+		return 0;
+	}
+	
+	// time is changed by interrupt service routine
+	// year has 6 bits: 2064 and later are packed as 2000 and later again
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		time = ((uint32_t)(systemTime.year & 0x3F) << 26) |
+			   ((uint32_t)(systemTime.month & 0x0F) << 22) |
+			   ((uint32_t)(systemTime.day & 0x1F) << 17) |
+			   ((uint32_t)(systemTime.hour & 0x1F) << 12) |
+			   ((uint16_t)(systemTime.minute & 0x3F) << 6) |
+			   (systemTime.second & 0x3F);
+	}
+	return time;
+}
+
+//! Get number of dropped entries (saturated)
+uint8_t getLogDropped(void)
+{
+	return logDropped;
+}
+
+//! Check for entries not written to eeprom yet (waiting or being written)
+uint8_t getLogPending(void)
+{
+	return logWaiting || logWriting;
+}
+
+//! Get next write position in eeprom, the oldest entry of a full log
+uint8_t getLogHead(void)
+{
+	return logHead;
+}
+
+//! thread: write waiting entries in batches, waits for the eeprom
+uint8_t threadLog(void)
+{
+	static struct pt pt;
+	static struct logEntry entry;
+	static uint16_t start;
+	static uint8_t *address;
+	static uint8_t i;
+	
+	PT_BEGIN(&pt);
+	
+	while(1)
+	{
+		PT_WAIT_UNTIL(&pt, logWaiting);
+		
+		// wait for a batch, a flush request or the flush time
+		start = getSystemTicks();
+		PT_WAIT_UNTIL(&pt, (logWaiting >= LOG_BATCH) || logFlush ||
+					  ((uint16_t)(getSystemTicks() - start) >= PT_MS_TO_TICKS(LOG_FLUSH_TIME)));
+		logFlush = 0;
+		
+		// write all waiting entries, also the ones logged meanwhile
+		while(logWaiting)
+		{
+			// take oldest entry out of buffer
+			logWriting = 1;
+			entry = logBuffer[0];
+			entry.sequence = logSequence;
+			logWaiting--;
+			for(i = 0; i < logWaiting; i++)
+			{
+				logBuffer[i] = logBuffer[i + 1];
+			}
+			
+			// sequence is written last: an interrupted entry breaks the
+			// sequence and is the next write position again
+			address = (uint8_t *)&eepromLog[logHead];
+			for(i = sizeof(struct logEntry); i > 0; i--)
+			{
+				PT_WAIT_UNTIL(&pt, eeprom_is_ready());
+				eeprom_update_byte(address + i - 1, ((uint8_t *)&entry)[i - 1]);
+			}
+			
+			logSequence++;
+			logHead = (logHead + 1) % LOG_ENTRIES;
+			logWriting = 0;
+		}
+	}
+	
+	PT_END(&pt);
+}
+
+#ifdef USART0_ENABLED
+
+//! Send one entry via usart 0 in one line: 'L', sequence, code, payload and
+// time in hex (26 characters)
+// input: position in eeprom (getLogHead() is the oldest entry)
+// return value is '0', means the entry is empty and nothing was sent
+uint8_t dumpLog(uint8_t position)
+{
+	struct logEntry entry;
+	uint8_t i = 0;
+	
+	eeprom_read_block(&entry, &eepromLog[position % LOG_ENTRIES], sizeof(entry));
+	if(entry.code == LOG_EVENT_NONE)
+	{
+		return 0;
+	}
+	
+	usart0Transmit('L');
+	for(i = 0; i < sizeof(entry); i++)
+	{
+		usart0Transmit(' ');
+		usart0TransmitHex(((uint8_t *)&entry)[i]);
+	}
+	usart0Transmit('\r');
+	usart0Transmit('\n');
+	return 1;
+}
+
+#endif
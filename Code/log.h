@@ -0,0 +1,55 @@
+/*******************************************************************************
+*
+*	Author:			Georg Bauer
+*	Date:			18.10.2026
+*
+*	Project-Title:	ClockWise
+*	Description:	Event log as ring buffer in eeprom
+*
+*	File-Title:		Event Log - Header File
+*
+*******************************************************************************
+*/
+
+//! Libraries
+#include <avr/io.h>
+#include <avr/eeprom.h>
+#include <stdint.h>
+
+//! entry of event log (8 bytes in eeprom)
+struct logEntry
+{
+	uint8_t sequence;	// write counter, consecutive in ring order
+	uint8_t code;		// event (see LOG_EVENT_*), LOG_EVENT_NONE is an empty entry
+	uint16_t payload;	// data of event
+	uint32_t time;		// packed system time (see packLogTime()), 0 if not available
+};
+
+//! Functional prototypes
+void initLog(void);
+void logEvent(uint8_t code, uint16_t payload);
+void flushLog(void);
+uint32_t packLogTime(void);
+uint8_t getLogDropped(void);
+uint8_t getLogPending(void);
+uint8_t getLogHead(void);
+uint8_t threadLog(void);
+uint8_t dumpLog(uint8_t position);
+
+//! Events
+#define LOG_EVENT_NONE				0xFF	// empty entry (erased eeprom)
+#define LOG_EVENT_RESET				1		// reset, payload: reset flags (MCUSR)
+#define LOG_EVENT_DCF_SYNC			2		// dcf77 time accepted, payload: not used
+#define LOG_EVENT_DCF_FAIL			3		// dcf77 frames rejected, payload: count << 8 | reason
+#define LOG_EVENT_MANUAL_TIME		4		// time set in menu, payload: not used
+#define LOG_EVENT_SUPPLY_LOW		5		// supply below derating voltage, payload: voltage in mV
+#define LOG_EVENT_RTC_ERROR			6		// rtc transaction failed, payload: bus errors << 8 | retries
+#define LOG_EVENT_RTC_WRITE			7		// dcf77 time written to rtc, payload: not used
+#define LOG_EVENT_WATCHDOG			8		// watchdog reset, payload: task << 8 | start-up since power on
+#define LOG_EVENT_WATCHDOG_STACK	9		// watchdog reset, payload: stack pointer (0: not saved)
+
+//! Reasons of rejected dcf77 frames
+#define LOG_DCF_PARITY_MINUTE		1		// parity of minute
+#define LOG_DCF_PARITY_HOUR			2		// parity of hour
+#define LOG_DCF_PARITY_DATE			3		// parity of date
+#define LOG_DCF_PLAUSIBILITY		4		// not consecutive to last frame
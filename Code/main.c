@@ -22,21 +22,29 @@
 *
 * Fuse settings by programming via SPI:
 *	BODLEVEL = DISABLED
-*	OCDEN = [X]
+*	OCDEN = [ ]
 *	JTAGEN = [X]
 *	SPIEN = [ ]
 *	WDTON = [ ]
 *	EESAVE = [ ]
 *	BOOTSZ = 4096W_F000
-*	BOOTRST = [ ]
+*	BOOTRST = [X]
 *	CKDIV8 = [ ]
-*	CKOUT = [X]
+*	CKOUT = [ ]
 *	SUT_CKSEL = EXTXOSC_8MHZ_XX_1CK_65MS
 *
 *	EXTENDED = 0xFF (valid)
-*	HIGH = 0xB9 (valid)
+*	HIGH = 0xB8 (valid)
 *	LOW = 0xCF (valid)
 *
+* BOOTRST starts the serial bootloader in the boot section after a reset
+* (see Bootloader/bootloader.c), it's programmed once via SPI together with
+* the fuses. Firmware updates are done with Tools/upload.py on usart 0. The
+* lock bits BLB1 = SPM_DISABLE (LOCKBIT = 0xEF) protect the bootloader.
+* Usart 0 needs RSTREG tied to +5V (see settings.h). The console command
+* 'boot' needs USART0_ENABLED (disabled by default), without it the clock
+* is switched on (or reset) while Tools/upload.py is waiting.
+*
 *******************************************************************************
 */
   
@@ -50,9 +58,19 @@
 #include "rtc.h"
 #include "gpios.h"
 #include "timeMgnt.h"
+#include "profiler.h"
 
-//#include "usart.h"
+#include "usart.h"
 #include "adc.h"
+#include "brightness.h"
+#include "nightMgnt.h"
+#include "buttons.h"
+#include "config.h"
+#include "log.h"
+#include "console.h"
+#include "menu.h"
+#include "telemetry.h"
+#include "displayMatrix.h"
 
 //#include <util/delay.h>
 
@@ -73,82 +91,110 @@ int main(void)
 	
 	// init functions
 	initSystem();		// global settings
-	initGpios();		// external interrupts via switches
+	initConfig();		// saved configuration (eeprom)
+	initLog();			// event log (eeprom)
+	initGpios();		// status leds, dots and switches
+	initButtons();		// timer 3 for debouncing switches
 	initTimeMgnt();		// timer 1 for time management
 	initRtc();			// rtc communication
 	initAdc();			// adcs for brightness and
+	initBrightness();	// brightness pipeline of display
+	initNightMgnt();	// night schedule of display
+	initMenu();			// index of menu transitions
 	initMatrix();		// matrix management
 	initDcf77();		// dcf77 management
 	initTasks();		// task management
+#ifdef TASK_PROFILING
+	initProfiler();		// task profiling
+#endif
+#ifdef USART0_ENABLED
+	initUsart0();		// serial output
+	// report watchdog reset: 'W', number of resets, task, start-up since
+	// power on and stack pointer of last reset
+	if(getResetFlags() & (1 << WDRF))
+	{
+		usart0Transmit('W');
+		usart0TransmitHex(getSupervisorResets());
+		usart0Transmit(' ');
+		usart0TransmitHex(getSupervisorResetTask());
+		usart0Transmit(' ');
+		usart0TransmitHex(getSupervisorResetSequence());
+		usart0Transmit(' ');
+		usart0TransmitHex(getSupervisorResetStack() >> 8);
+		usart0TransmitHex(getSupervisorResetStack());
+		usart0Transmit('\r');
+		usart0Transmit('\n');
+	}
+	// command console (output is sent after sei())
+	initConsole();
+#endif
+#ifdef TELEMETRY_ENABLED
+	initTelemetry();	// telemetry stream, inactive until 'tele on'
+#endif
 
-	// read light intensity value of adc
-	systemConfig.lightIntensity = calculateIntensity(adcRead(0));
-	// read potentiometer value of adc
-	systemConfig.potentiometerValue = calculatePotiValue(adcRead(1));
-	// calculate display brightness value
-	systemConfig.displayBrightness = calcuateBrightness(systemConfig.lightIntensity, systemConfig.potentiometerValue);
-
-	// enable global interrupt
+	// enable global interrupt, the first adc round starts now
+	// and actualizes the display brightness after a few ms
 	sei();
 	
 	// switsch off test leds
 	switchOffStatusYellow();
 	switchOffStatusRed();
 	
-	// nur bergangsweise fr version v0.0.2
-	// nehme default time und suche nicht automatisch im boot-up
-	
 	// set default system status
 	// - xxxx.xxx0b time value not available
 	// - xxxx.xx1xb searching dcf77 signal active
 	// - xxxx.x0xxb rtc time is not available
 	// - xxxx.0xxxb setting menu is inactive
-	// - xxx0.xxxxb automatic time mode is active
-	systemConfig.status = 0x02;
-	// start receiving
+	// - xxxx.xxxxb time mode of saved configuration
+	systemConfig.status = (systemConfig.status & 0x10) | 0x02;
+	// start receiving, dcf77 corrects the time in background
 	startDcf77Signal();
-								
-	// set new display status: show searching mode
-	systemConfig.displayStatus = DISPLAY_STATE_SEARCH;
-					
-/*
-	// check for data from rtc
-	// if the rtc communication is failed 
-	if(~getTimeFromRtc())
-	{
-		// start receiving
-		startDcf77Signal();
-		// set default system status
-		// - xxxx.xx1xb searching dcf77 signal active
-		systemConfig.status |= 0x02;
-		// set display status to searching sequence
-		systemConfig.displayStatus = DISPLAY_STATE_SEARCH;
-		// - xxxx.xxx0b no time value available
-		// - xxxx.x0xxb rtc time is not available
-		systemConfig.status &= ~0x05;
-	}
-	else
+	
+	// check for data from rtc (burst read takes about 1ms)
+	// if the rtc is running, the first frame shows its time
+	if(loadTimeFromRtc())
 	{
-		// set default system status
 		// - xxxx.xxx1b time information in system available
 		// - xxxx.x1xxb rtc time is available
 		systemConfig.status |= 0x05;
-		// - xxxx.xx0xb searching dcf77 signal inactive
-		systemConfig.status &= ~0x02;
+		// manual time mode: no dcf77 reception
+		if(systemConfig.status & 0x10)
+		{
+			stopDcf77Signal();
+		}
+		// actualize matrix information
+		displayMatrixInformation();
+		// 1Hz square wave of rtc as timebase of seconds is requested with
+		// the valid time (see decodeRtc())
 	}
-*/
+	else
+	{
+		// set new display status: show searching mode
+		systemConfig.displayStatus = DISPLAY_STATE_SEARCH;
+	}
+	
+	// log reset cause (with rtc time, if available)
+	logEvent(LOG_EVENT_RESET, getResetFlags());
+	// log crash context of watchdog reset
+	if(getResetFlags() & (1 << WDRF))
+	{
+		logEvent(LOG_EVENT_WATCHDOG, (getSupervisorResetTask() << 8) | getSupervisorResetSequence());
+		logEvent(LOG_EVENT_WATCHDOG_STACK, getSupervisorResetStack());
+	}
+	flushLog();
 	// endless loop
     while (1) 					
 	{
+		// handle events of interrupt service routines
+		checkForEvent();
+		
 		// when do nothing
 		checkForTask();
 		
-		// and
-			// read light intensity value of adc
-			systemConfig.lightIntensity = calculateIntensity(adcRead(0));
-			// read potentiometer value of adc
-			systemConfig.potentiometerValue = calculatePotiValue(adcRead(1));
-			// calculate display brightness value
-			systemConfig.displayBrightness = calcuateBrightness(systemConfig.lightIntensity, systemConfig.potentiometerValue);
+		// continue waiting threads
+		checkForThreads();
+		
+		// feed watchdog, if all tasks are in time
+		checkSupervisor();
     }	
 }
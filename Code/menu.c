@@ -7,10 +7,15 @@
 *	Description:	C controlled clock with DCF77, RTC and a led-matrix
 *
 *	File-Title:		Menu Management, selectable via switches
-*					(press okey and cancel at the same time)
+*					(long press of okey)
 *
 *******************************************************************************
 *
+* The menu is a state machine in flash: every transition of 'menuTransitions'
+* is a display status, the switches of the event, the next display status and
+* an action. The first transition of the actual display status which matches a
+* pressed switch is taken. The screens of the states are described in
+* 'menuScreens' (see ledMatrix.c).
 *
 *******************************************************************************
 */
@@ -18,307 +23,480 @@
 //! libraries
 #include "menu.h"
 #include "system.h"
+#include "settings.h"
 #include "dcf77.h"
 #include "gpios.h"
+#include "buttons.h"
 #include "displayMatrix.h"
+#include "profiler.h"
+#include "config.h"
+#include "log.h"
+#include "rtc.h"
+#include "console.h"
+#include <avr/pgmspace.h>
 
 //! Own global variables
 volatile struct time setTime;
 
+//! Transitions of menu, sorted by state (see initMenu())
+const struct menuTransition menuTransitions[] PROGMEM =
+{
+	// version
+	{DISPLAY_STATE_MENU_VERSION, BUTTON_UP, DISPLAY_STATE_MENU_TIME_MODE, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_VERSION, BUTTON_DOWN, DISPLAY_STATE_MENU_DBG, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_VERSION, BUTTON_CANCEL, DISPLAY_STATE_DARK, MENU_ACTION_EXIT, 0},
+	// time mode
+	{DISPLAY_STATE_MENU_TIME_MODE, BUTTON_OK, DISPLAY_STATE_MENU_AUTO_MODE, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_TIME_MODE, BUTTON_UP, DISPLAY_STATE_MENU_SETTINGS, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_TIME_MODE, BUTTON_DOWN, DISPLAY_STATE_MENU_VERSION, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_TIME_MODE, BUTTON_CANCEL, DISPLAY_STATE_DARK, MENU_ACTION_EXIT, 0},
+	// auto mode
+	{DISPLAY_STATE_MENU_AUTO_MODE, BUTTON_OK, DISPLAY_STATE_MENU_AUTO_CANCEL, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_AUTO_MODE, BUTTON_UP | BUTTON_DOWN, DISPLAY_STATE_MENU_MANUAL_MODE, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_AUTO_MODE, BUTTON_CANCEL, DISPLAY_STATE_MENU_TIME_MODE, MENU_ACTION_NONE, 0},
+	// auto cancel
+	{DISPLAY_STATE_MENU_AUTO_CANCEL, BUTTON_OK, DISPLAY_STATE_MENU_AUTO_MODE, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_AUTO_CANCEL, BUTTON_UP | BUTTON_DOWN, DISPLAY_STATE_MENU_AUTO_OK, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_AUTO_CANCEL, BUTTON_CANCEL, DISPLAY_STATE_MENU_AUTO_MODE, MENU_ACTION_NONE, 0},
+	// auto ok
+	{DISPLAY_STATE_MENU_AUTO_OK, BUTTON_OK, DISPLAY_STATE_DARK, MENU_ACTION_START_DCF, 0},
+	{DISPLAY_STATE_MENU_AUTO_OK, BUTTON_UP | BUTTON_DOWN, DISPLAY_STATE_MENU_AUTO_CANCEL, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_AUTO_OK, BUTTON_CANCEL, DISPLAY_STATE_MENU_AUTO_MODE, MENU_ACTION_NONE, 0},
+	// manual mode
+	{DISPLAY_STATE_MENU_MANUAL_MODE, BUTTON_OK, DISPLAY_STATE_MENU_MANUAL_CANCEL, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_MANUAL_MODE, BUTTON_UP | BUTTON_DOWN, DISPLAY_STATE_MENU_AUTO_MODE, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_MANUAL_MODE, BUTTON_CANCEL, DISPLAY_STATE_MENU_TIME_MODE, MENU_ACTION_NONE, 0},
+	// manual cancel
+	{DISPLAY_STATE_MENU_MANUAL_CANCEL, BUTTON_OK, DISPLAY_STATE_MENU_MANUAL_MODE, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_MANUAL_CANCEL, BUTTON_UP | BUTTON_DOWN, DISPLAY_STATE_MENU_MANUAL_OK, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_MANUAL_CANCEL, BUTTON_CANCEL, DISPLAY_STATE_MENU_MANUAL_MODE, MENU_ACTION_NONE, 0},
+	// manual ok
+	{DISPLAY_STATE_MENU_MANUAL_OK, BUTTON_OK, DISPLAY_STATE_MENU_SET_HOUR, MENU_ACTION_LOAD_TIME, 0},
+	{DISPLAY_STATE_MENU_MANUAL_OK, BUTTON_UP | BUTTON_DOWN, DISPLAY_STATE_MENU_MANUAL_CANCEL, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_MANUAL_OK, BUTTON_CANCEL, DISPLAY_STATE_MENU_MANUAL_MODE, MENU_ACTION_NONE, 0},
+	// set hour
+	{DISPLAY_STATE_MENU_SET_HOUR, BUTTON_OK, DISPLAY_STATE_MENU_SET_MINUTE, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_SET_HOUR, BUTTON_UP, DISPLAY_STATE_MENU_SET_HOUR, MENU_ACTION_INCREMENT, 0},
+	{DISPLAY_STATE_MENU_SET_HOUR, BUTTON_DOWN, DISPLAY_STATE_MENU_SET_HOUR, MENU_ACTION_DECREMENT, 0},
+	{DISPLAY_STATE_MENU_SET_HOUR, BUTTON_CANCEL, DISPLAY_STATE_MENU_SET_CANCEL, MENU_ACTION_NONE, 0},
+	// set minute
+	{DISPLAY_STATE_MENU_SET_MINUTE, BUTTON_OK, DISPLAY_STATE_MENU_SET_SECOND, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_SET_MINUTE, BUTTON_UP, DISPLAY_STATE_MENU_SET_MINUTE, MENU_ACTION_INCREMENT, 0},
+	{DISPLAY_STATE_MENU_SET_MINUTE, BUTTON_DOWN, DISPLAY_STATE_MENU_SET_MINUTE, MENU_ACTION_DECREMENT, 0},
+	{DISPLAY_STATE_MENU_SET_MINUTE, BUTTON_CANCEL, DISPLAY_STATE_MENU_SET_HOUR, MENU_ACTION_NONE, 0},
+	// set second
+	{DISPLAY_STATE_MENU_SET_SECOND, BUTTON_OK, DISPLAY_STATE_MENU_SET_DAY, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_SET_SECOND, BUTTON_UP, DISPLAY_STATE_MENU_SET_SECOND, MENU_ACTION_INCREMENT, 0},
+	{DISPLAY_STATE_MENU_SET_SECOND, BUTTON_DOWN, DISPLAY_STATE_MENU_SET_SECOND, MENU_ACTION_DECREMENT, 0},
+	{DISPLAY_STATE_MENU_SET_SECOND, BUTTON_CANCEL, DISPLAY_STATE_MENU_SET_MINUTE, MENU_ACTION_NONE, 0},
+	// set year
+	{DISPLAY_STATE_MENU_SET_YEAR, BUTTON_OK, DISPLAY_STATE_MENU_SET_WEEKDAY, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_SET_YEAR, BUTTON_UP, DISPLAY_STATE_MENU_SET_YEAR, MENU_ACTION_INCREMENT, 0},
+	{DISPLAY_STATE_MENU_SET_YEAR, BUTTON_DOWN, DISPLAY_STATE_MENU_SET_YEAR, MENU_ACTION_DECREMENT, 0},
+	{DISPLAY_STATE_MENU_SET_YEAR, BUTTON_CANCEL, DISPLAY_STATE_MENU_SET_MONTH, MENU_ACTION_NONE, 0},
+	// set month
+	{DISPLAY_STATE_MENU_SET_MONTH, BUTTON_OK, DISPLAY_STATE_MENU_SET_YEAR, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_SET_MONTH, BUTTON_UP, DISPLAY_STATE_MENU_SET_MONTH, MENU_ACTION_INCREMENT, 0},
+	{DISPLAY_STATE_MENU_SET_MONTH, BUTTON_DOWN, DISPLAY_STATE_MENU_SET_MONTH, MENU_ACTION_DECREMENT, 0},
+	{DISPLAY_STATE_MENU_SET_MONTH, BUTTON_CANCEL, DISPLAY_STATE_MENU_SET_DAY, MENU_ACTION_NONE, 0},
+	// set day
+	{DISPLAY_STATE_MENU_SET_DAY, BUTTON_OK, DISPLAY_STATE_MENU_SET_MONTH, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_SET_DAY, BUTTON_UP, DISPLAY_STATE_MENU_SET_DAY, MENU_ACTION_INCREMENT, 0},
+	{DISPLAY_STATE_MENU_SET_DAY, BUTTON_DOWN, DISPLAY_STATE_MENU_SET_DAY, MENU_ACTION_DECREMENT, 0},
+	{DISPLAY_STATE_MENU_SET_DAY, BUTTON_CANCEL, DISPLAY_STATE_MENU_SET_SECOND, MENU_ACTION_NONE, 0},
+	// set weekday
+	{DISPLAY_STATE_MENU_SET_WEEKDAY, BUTTON_OK, DISPLAY_STATE_MENU_SET_OK, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_SET_WEEKDAY, BUTTON_UP, DISPLAY_STATE_MENU_SET_WEEKDAY, MENU_ACTION_INCREMENT, 0},
+	{DISPLAY_STATE_MENU_SET_WEEKDAY, BUTTON_DOWN, DISPLAY_STATE_MENU_SET_WEEKDAY, MENU_ACTION_DECREMENT, 0},
+	{DISPLAY_STATE_MENU_SET_WEEKDAY, BUTTON_CANCEL, DISPLAY_STATE_MENU_SET_YEAR, MENU_ACTION_NONE, 0},
+	// set cancel
+	{DISPLAY_STATE_MENU_SET_CANCEL, BUTTON_OK, DISPLAY_STATE_MENU_MANUAL_MODE, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_SET_CANCEL, BUTTON_UP | BUTTON_DOWN, DISPLAY_STATE_MENU_SET_OK, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_SET_CANCEL, BUTTON_CANCEL, DISPLAY_STATE_MENU_SET_HOUR, MENU_ACTION_NONE, 0},
+	// set ok
+	{DISPLAY_STATE_MENU_SET_OK, BUTTON_OK, DISPLAY_STATE_DARK, MENU_ACTION_STORE_TIME, 0},
+	{DISPLAY_STATE_MENU_SET_OK, BUTTON_UP | BUTTON_DOWN, DISPLAY_STATE_MENU_SET_CANCEL, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_SET_OK, BUTTON_CANCEL, DISPLAY_STATE_MENU_SET_HOUR, MENU_ACTION_NONE, 0},
+	// settings
+	{DISPLAY_STATE_MENU_SETTINGS, BUTTON_OK, DISPLAY_STATE_MENU_BRIGTHNESS, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_SETTINGS, BUTTON_UP, DISPLAY_STATE_MENU_DBG, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_SETTINGS, BUTTON_DOWN, DISPLAY_STATE_MENU_TIME_MODE, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_SETTINGS, BUTTON_CANCEL, DISPLAY_STATE_DARK, MENU_ACTION_EXIT, 0},
+	// brightness
+	{DISPLAY_STATE_MENU_BRIGTHNESS, BUTTON_OK, DISPLAY_STATE_MENU_BRIGHT_AUTO, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_BRIGTHNESS, BUTTON_UP, DISPLAY_STATE_MENU_PIE, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_BRIGTHNESS, BUTTON_DOWN, DISPLAY_STATE_MENU_SEARCH_MODE, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_BRIGTHNESS, BUTTON_CANCEL, DISPLAY_STATE_MENU_SETTINGS, MENU_ACTION_NONE, 0},
+	// bright auto
+	{DISPLAY_STATE_MENU_BRIGHT_AUTO, BUTTON_OK, DISPLAY_STATE_MENU_BRIGTHNESS, MENU_ACTION_SET_SETTING, 0x40},
+	{DISPLAY_STATE_MENU_BRIGHT_AUTO, BUTTON_UP | BUTTON_DOWN, DISPLAY_STATE_MENU_BRIGHT_MANU, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_BRIGHT_AUTO, BUTTON_CANCEL, DISPLAY_STATE_MENU_BRIGTHNESS, MENU_ACTION_NONE, 0},
+	// bright manu
+	{DISPLAY_STATE_MENU_BRIGHT_MANU, BUTTON_OK, DISPLAY_STATE_MENU_BRIGHT_VALUE, MENU_ACTION_CLEAR_SETTING, 0x40},
+	{DISPLAY_STATE_MENU_BRIGHT_MANU, BUTTON_UP | BUTTON_DOWN, DISPLAY_STATE_MENU_BRIGHT_AUTO, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_BRIGHT_MANU, BUTTON_CANCEL, DISPLAY_STATE_MENU_BRIGTHNESS, MENU_ACTION_NONE, 0},
+	// bright value
+	{DISPLAY_STATE_MENU_BRIGHT_VALUE, BUTTON_OK, DISPLAY_STATE_MENU_BRIGTHNESS, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_BRIGHT_VALUE, BUTTON_UP, DISPLAY_STATE_MENU_BRIGHT_VALUE, MENU_ACTION_INCREMENT, 0},
+	{DISPLAY_STATE_MENU_BRIGHT_VALUE, BUTTON_DOWN, DISPLAY_STATE_MENU_BRIGHT_VALUE, MENU_ACTION_DECREMENT, 0},
+	{DISPLAY_STATE_MENU_BRIGHT_VALUE, BUTTON_CANCEL, DISPLAY_STATE_MENU_BRIGTHNESS, MENU_ACTION_NONE, 0},
+	// pie
+	{DISPLAY_STATE_MENU_PIE, BUTTON_OK, DISPLAY_STATE_MENU_PIE_STRAIGHT, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_PIE, BUTTON_UP, DISPLAY_STATE_MENU_CHAR, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_PIE, BUTTON_DOWN, DISPLAY_STATE_MENU_BRIGTHNESS, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_PIE, BUTTON_CANCEL, DISPLAY_STATE_MENU_SETTINGS, MENU_ACTION_NONE, 0},
+	// pie straight
+	{DISPLAY_STATE_MENU_PIE_STRAIGHT, BUTTON_OK, DISPLAY_STATE_MENU_PIE, MENU_ACTION_CLEAR_SETTING, 0x01},
+	{DISPLAY_STATE_MENU_PIE_STRAIGHT, BUTTON_UP | BUTTON_DOWN, DISPLAY_STATE_MENU_PIE_SHIFT, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_PIE_STRAIGHT, BUTTON_CANCEL, DISPLAY_STATE_MENU_PIE, MENU_ACTION_NONE, 0},
+	// pie shift
+	{DISPLAY_STATE_MENU_PIE_SHIFT, BUTTON_OK, DISPLAY_STATE_MENU_PIE_MINUTES, MENU_ACTION_SET_SETTING, 0x01},
+	{DISPLAY_STATE_MENU_PIE_SHIFT, BUTTON_UP | BUTTON_DOWN, DISPLAY_STATE_MENU_PIE_STRAIGHT, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_PIE_SHIFT, BUTTON_CANCEL, DISPLAY_STATE_MENU_PIE, MENU_ACTION_NONE, 0},
+	// pie minutes
+	{DISPLAY_STATE_MENU_PIE_MINUTES, BUTTON_OK, DISPLAY_STATE_MENU_PIE, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_PIE_MINUTES, BUTTON_UP, DISPLAY_STATE_MENU_PIE_MINUTES, MENU_ACTION_INCREMENT, 0},
+	{DISPLAY_STATE_MENU_PIE_MINUTES, BUTTON_DOWN, DISPLAY_STATE_MENU_PIE_MINUTES, MENU_ACTION_DECREMENT, 0},
+	{DISPLAY_STATE_MENU_PIE_MINUTES, BUTTON_CANCEL, DISPLAY_STATE_MENU_PIE, MENU_ACTION_NONE, 0},
+	// char
+	{DISPLAY_STATE_MENU_CHAR, BUTTON_OK, DISPLAY_STATE_MENU_CHAR_STANDARD, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_CHAR, BUTTON_UP, DISPLAY_STATE_MENU_SEARCH_MODE, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_CHAR, BUTTON_DOWN, DISPLAY_STATE_MENU_PIE, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_CHAR, BUTTON_CANCEL, DISPLAY_STATE_MENU_SETTINGS, MENU_ACTION_NONE, 0},
+	// char standard
+	{DISPLAY_STATE_MENU_CHAR_STANDARD, BUTTON_OK, DISPLAY_STATE_MENU_CHAR, MENU_ACTION_CLEAR_SETTING, 0x0E},
+	{DISPLAY_STATE_MENU_CHAR_STANDARD, BUTTON_UP | BUTTON_DOWN, DISPLAY_STATE_MENU_CHAR_BIRTHDAY, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_CHAR_STANDARD, BUTTON_CANCEL, DISPLAY_STATE_MENU_CHAR, MENU_ACTION_NONE, 0},
+	// char birthday
+	{DISPLAY_STATE_MENU_CHAR_BIRTHDAY, BUTTON_OK, DISPLAY_STATE_MENU_CHAR, MENU_ACTION_SET_SETTING, 0x02},
+	{DISPLAY_STATE_MENU_CHAR_BIRTHDAY, BUTTON_UP | BUTTON_DOWN, DISPLAY_STATE_MENU_CHAR_STANDARD, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_CHAR_BIRTHDAY, BUTTON_CANCEL, DISPLAY_STATE_MENU_CHAR, MENU_ACTION_NONE, 0},
+	// search mode
+	{DISPLAY_STATE_MENU_SEARCH_MODE, BUTTON_OK, DISPLAY_STATE_MENU_SEARCH_NO, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_SEARCH_MODE, BUTTON_UP, DISPLAY_STATE_MENU_BRIGTHNESS, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_SEARCH_MODE, BUTTON_DOWN, DISPLAY_STATE_MENU_CHAR, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_SEARCH_MODE, BUTTON_CANCEL, DISPLAY_STATE_MENU_SETTINGS, MENU_ACTION_NONE, 0},
+	// search square
+	{DISPLAY_STATE_MENU_SEARCH_SQUARE, BUTTON_OK, DISPLAY_STATE_MENU_SEARCH_MODE, MENU_ACTION_CLEAR_SETTING, 0x80},
+	{DISPLAY_STATE_MENU_SEARCH_SQUARE, BUTTON_UP | BUTTON_DOWN, DISPLAY_STATE_MENU_SEARCH_NO, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_SEARCH_SQUARE, BUTTON_CANCEL, DISPLAY_STATE_MENU_SEARCH_MODE, MENU_ACTION_NONE, 0},
+	// search no
+	{DISPLAY_STATE_MENU_SEARCH_NO, BUTTON_OK, DISPLAY_STATE_MENU_SEARCH_MODE, MENU_ACTION_SET_SETTING, 0x80},
+	{DISPLAY_STATE_MENU_SEARCH_NO, BUTTON_UP | BUTTON_DOWN, DISPLAY_STATE_MENU_SEARCH_SQUARE, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_SEARCH_NO, BUTTON_CANCEL, DISPLAY_STATE_MENU_SEARCH_MODE, MENU_ACTION_NONE, 0},
+	// dbg
+	{DISPLAY_STATE_MENU_DBG, BUTTON_OK, DISPLAY_STATE_MENU_DBG1, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_DBG, BUTTON_UP, DISPLAY_STATE_MENU_VERSION, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_DBG, BUTTON_DOWN, DISPLAY_STATE_MENU_SETTINGS, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_DBG, BUTTON_CANCEL, DISPLAY_STATE_DARK, MENU_ACTION_EXIT, 0},
+	// dbg1
+	{DISPLAY_STATE_MENU_DBG1, BUTTON_OK, DISPLAY_STATE_MENU_DBG1, MENU_ACTION_PROFILE_NEXT, 0},
+	{DISPLAY_STATE_MENU_DBG1, BUTTON_UP, DISPLAY_STATE_MENU_DBG2, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_DBG1, BUTTON_DOWN, DISPLAY_STATE_MENU_DBG4, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_DBG1, BUTTON_CANCEL, DISPLAY_STATE_MENU_DBG, MENU_ACTION_NONE, 0},
+	// dbg2
+	{DISPLAY_STATE_MENU_DBG2, BUTTON_OK, DISPLAY_STATE_MENU_DBG2, MENU_ACTION_PROFILE_NEXT, 0},
+	{DISPLAY_STATE_MENU_DBG2, BUTTON_UP, DISPLAY_STATE_MENU_DBG3, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_DBG2, BUTTON_DOWN, DISPLAY_STATE_MENU_DBG1, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_DBG2, BUTTON_CANCEL, DISPLAY_STATE_MENU_DBG, MENU_ACTION_NONE, 0},
+	// dbg3
+	{DISPLAY_STATE_MENU_DBG3, BUTTON_OK, DISPLAY_STATE_MENU_DBG3, MENU_ACTION_PROFILE_DUMP, 0},
+	{DISPLAY_STATE_MENU_DBG3, BUTTON_UP, DISPLAY_STATE_MENU_DBG4, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_DBG3, BUTTON_DOWN, DISPLAY_STATE_MENU_DBG2, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_DBG3, BUTTON_CANCEL, DISPLAY_STATE_MENU_DBG, MENU_ACTION_NONE, 0},
+	// dbg4
+	{DISPLAY_STATE_MENU_DBG4, BUTTON_OK, DISPLAY_STATE_MENU_DBG4, MENU_ACTION_LOG_DUMP, 0},
+	{DISPLAY_STATE_MENU_DBG4, BUTTON_UP, DISPLAY_STATE_MENU_DBG1, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_DBG4, BUTTON_DOWN, DISPLAY_STATE_MENU_DBG3, MENU_ACTION_NONE, 0},
+	{DISPLAY_STATE_MENU_DBG4, BUTTON_CANCEL, DISPLAY_STATE_MENU_DBG, MENU_ACTION_NONE, 0}
+};
+
+// first transition of every menu state (index: state - DISPLAY_STATE_MENU_VERSION),
+// the transitions of a state end at the first one of the next state
+uint8_t menuTransitionStart[MENU_STATES + 1];
+
 //! Extern global variables
 extern volatile struct systemParameter systemConfig;
 extern volatile struct time systemTime;
 
+//! Initialize menu: index of transitions by state
+void initMenu(void)
+{
+	uint8_t i = 0;
+	uint16_t state = 0;
+	
+	for(state = 0; state <= MENU_STATES; state++)
+	{
+		// skip transitions of lower states
+		while((i < MENU_TRANSITIONS) &&
+			  (pgm_read_byte(&menuTransitions[i].state) < state + DISPLAY_STATE_MENU_VERSION))
+		{
+			i++;
+		}
+		menuTransitionStart[state] = i;
+	}
+}
+
+//! handles a switch event in main loop
+// input: actual values for switches, posted by button driver
+void menuSwitchEvent(uint8_t switches)
+{
+	// any thing else is pressed in the menu mode
+	if(systemConfig.displayStatus >= DISPLAY_STATE_MENU_WAIT)
+	{
+		// call menu management function
+		menuMgnt(switches);
+	}
+	// up or down in standard mode with available time: change view
+	else if((systemConfig.status & 0x01) && (switches & (BUTTON_UP | BUTTON_DOWN)))
+	{
+		changeDisplayView(switches & BUTTON_UP);
+		
+		// actualize matrix information
+		displayMatrixInformation();
+	}
+}
+
+//! handles a long press event in main loop
+// input: switches hold for a long time, posted by button driver
+void menuLongPressEvent(uint8_t switches)
+{
+	// only ok is hold in standard mode: enter menu
+	if((switches == BUTTON_OK) && (systemConfig.displayStatus < DISPLAY_STATE_MENU_WAIT))
+	{
+		// set new display status: show version
+		systemConfig.displayStatus = DISPLAY_STATE_MENU_VERSION;
+		// set default system status
+		// - xxxx.1xxxb setting menu is active
+		systemConfig.status |= 0x08;
+		
+		// actualize matrix information
+		displayMatrixInformation();
+	}
+}
+
 //! makes menu management
 // input: switch 
 void menuMgnt(uint8_t switches)
 {
-	// declaration of switch variables
-	uint8_t okSwitch, cancelSwitch, upSwitch, downSwitch;
-	cancelSwitch = switches & 0x01;
-	downSwitch = (switches & 0x02) >> 1;
-	upSwitch = (switches & 0x04) >> 2;
-	okSwitch = (switches & 0x08) >> 3;
+	uint8_t i = 0;
+	uint8_t last = 0;
+	uint8_t next = 0;
 	
-	switch(systemConfig.displayStatus)
+	// no menu state (wait to get into the menu)
+	if(systemConfig.displayStatus < DISPLAY_STATE_MENU_VERSION)
+	{
+		return;
+	}
+	
+	// search first transition of actual display status with a pressed switch
+	i = menuTransitionStart[systemConfig.displayStatus - DISPLAY_STATE_MENU_VERSION];
+	last = menuTransitionStart[systemConfig.displayStatus - DISPLAY_STATE_MENU_VERSION + 1];
+	for(; i < last; i++)
 	{
-		// default status: wait to get into menu
-		case DISPLAY_STATE_MENU_WAIT:
+		if(pgm_read_byte(&menuTransitions[i].switches) & switches)
 		{
-			// set new display status: show version
-			systemConfig.displayStatus = DISPLAY_STATE_MENU_VERSION;
-			// set default system status
-			// - xxxx.1xxxb setting menu is active
-			systemConfig.status |= 0x08;
-		
-			// actualize matrix information
-			displayMatrixInformation(0);
 			break;
 		}
-		// show version
-		case DISPLAY_STATE_MENU_VERSION:
+	}
+	// no switch of state is pressed? do nothing
+	if(i >= last)
+	{
+		return;
+	}
+	next = pgm_read_byte(&menuTransitions[i].next);
+	
+	switch(pgm_read_byte(&menuTransitions[i].action))
+	{
+		// leave menu
+		case MENU_ACTION_EXIT:
 		{
-			// up switch is pressed
-			if(upSwitch)
-			{
-				// set new display status: time mode
-				systemConfig.displayStatus = DISPLAY_STATE_MENU_TIME_MODE;
-			}
-			// down switch is pressed
-			if(downSwitch)
-			{
-				// set new display status: debug menu
-				systemConfig.displayStatus = DISPLAY_STATE_MENU_DBG;
-			}
-			// cancel switch is pressed
-			if(cancelSwitch)
-			{
-				// call menu cancel routine
-				menuCancel();
-			}
+			// call menu cancel routine
+			menuCancel();
 			break;
 		}
 		
-			// time mode
-			case DISPLAY_STATE_MENU_TIME_MODE:
-			{
-				// ok switch is pressed
-				if(okSwitch)
-				{
-					// set new display status: automatic mode
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_AUTO_MODE;		
-				}
-				// down switch is pressed
-				if(downSwitch)
-				{
-					// set new display status: show version
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_VERSION;
-				}
-				// up switch is pressed
-				if(upSwitch)
-				{
-					// set new display status: display settings
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SETTINGS;
-				}
-				// cancel switch is pressed
-				if(cancelSwitch)
-				{
-					// call menu cancel routine
-					menuCancel();
-				}
-				break;
-			}
-		
-			// automatic mode
-			case DISPLAY_STATE_MENU_AUTO_MODE:
-			{
-				// ok switch is pressed
-				if(okSwitch)
-				{
-					// set new display status: search time cancel blinking
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_AUTO_CANCEL;
-				}
-				// up or down switch is pressed
-				if(upSwitch || downSwitch)
-				{
-					// set new display status: manual mode
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_MANUAL_MODE;
-				}
-				// cancel switch is pressed
-				if(cancelSwitch)
-				{
-					// set new display status: time mode
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_TIME_MODE;
-				}
-				break;
-			}
+		// search automatic dcf77 time
+		case MENU_ACTION_START_DCF:
+		{
+			// start receiving
+			startDcf77Signal();
 			
-			// automatic mode: search time cancel blinking
-			case DISPLAY_STATE_MENU_AUTO_CANCEL:
-			{
-				// ok switch is pressed
-				if(okSwitch)
-				{
-					// set new display status: time mode
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_AUTO_MODE;
-				}
-				// up or down switch is pressed
-				if(upSwitch || downSwitch)
-				{
-					// set new display status: search time ok blinking
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_AUTO_OK;
-				}
-				// cancel switch is pressed
-				if(cancelSwitch)
-				{
-					// set new display status: time mode
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_AUTO_MODE;
-				}
-				break;
-			}
+			// set system status
+			// - xxxx.xxx0b no time information in system available - the searching sequence is displayed
+			// - xxx0.xxxxb automatic time mode is active
+			systemConfig.status &= ~0x11;
+			// - xxxx.xx1xb searching for dcf77-signal is active
+			systemConfig.status |= 0x02;
 			
-			// automatic mode: search time ok blinking
-			case DISPLAY_STATE_MENU_AUTO_OK:
-			{
-				// ok switch is pressed
-				if(okSwitch)
-				{
-					// start receiving
-					startDcf77Signal();
-					
-					// set system status
-					// - xxxx.xxx0b no time information in system available - the searching sequence is displayed
-					// - xxx0.xxxxb automatic time mode is active
-					systemConfig.status &= ~0x11;
-					// - xxxx.xx1xb searching for dcf77-signal is active
-					systemConfig.status |= 0x02;
-					
-					// set new display status: show searching mode
-					systemConfig.displayStatus = DISPLAY_STATE_SEARCH;
-															
-					// call menu cancel routine
-					menuCancel();
-				}
-				// up or down switch is pressed
-				if(upSwitch || downSwitch)
-				{
-					// set new display status: search time cancel blinking
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_AUTO_CANCEL;			
-				}
-				// cancel switch is pressed
-				if(cancelSwitch)
-				{
-					// set new display status: time mode
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_AUTO_MODE;
-				}
-				break;
-			}
+			// call menu cancel routine
+			menuCancel();
+			break;
+		}
 		
-			// manual mode
-			case DISPLAY_STATE_MENU_MANUAL_MODE:
+		// get time values to set manual
+		case MENU_ACTION_LOAD_TIME:
+		{
+			// get time values from system time (time management isr is running)
+			ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
 			{
-				// ok switch is pressed
-				if(okSwitch)
-				{
-					// set new display status: set time cancel blinking
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_MANUAL_CANCEL;
-				}
-				// up or down switch is pressed
-				if(upSwitch || downSwitch)
-				{
-					// set new display status: automatic mode
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_AUTO_MODE;
-				}
-				// cancel switch is pressed
-				if(cancelSwitch)
-				{
-					// set new display status: time mode
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_TIME_MODE;
-				}
-				break;
+				setTime = systemTime;
 			}
+			break;
+		}
+		
+		// take manual time
+		case MENU_ACTION_STORE_TIME:
+		{
+			storeManualTime();
+
+			// call menu cancel routine
+			menuCancel();
+			break;
+		}
+		
+		// increment or decrement value of actual display status
+		case MENU_ACTION_INCREMENT:
+		{
+			menuChangeValue(1);
+			break;
+		}
+		case MENU_ACTION_DECREMENT:
+		{
+			menuChangeValue(0);
+			break;
+		}
+		
+		// set or clear bits of system display settings (see system.h)
+		case MENU_ACTION_SET_SETTING:
+		{
+			systemConfig.displaySetting |= pgm_read_byte(&menuTransitions[i].parameter);
+			break;
+		}
+		case MENU_ACTION_CLEAR_SETTING:
+		{
+			systemConfig.displaySetting &= ~pgm_read_byte(&menuTransitions[i].parameter);
+			break;
+		}
+		
+		// select next profiled task
+		case MENU_ACTION_PROFILE_NEXT:
+		{
+#ifdef TASK_PROFILING
+			profileSelectNext();
+#endif
+			break;
+		}
 		
-			// set time cancel blinking
-			case DISPLAY_STATE_MENU_MANUAL_CANCEL:
+		// send task profiles via usart 0
+		case MENU_ACTION_PROFILE_DUMP:
+		{
+#if defined(TASK_PROFILING) && defined(USART0_ENABLED)
+			requestConsoleCommand(CONSOLE_COMMAND_PROFILE);
+#endif
+			break;
+		}
+		
+		// send event log via usart 0
+		case MENU_ACTION_LOG_DUMP:
+		{
+#ifdef USART0_ENABLED
+			requestConsoleCommand(CONSOLE_COMMAND_LOG);
+#endif
+			break;
+		}
+		
+		// only new display status
+		default:
+		{
+			break;
+		}
+	}
+	
+	// set new display status (if menu is still active)
+	if(systemConfig.status & 0x08)
+	{
+		systemConfig.displayStatus = next;
+	}
+	
+	// actualize matrix information, called by switch
+	displayMatrixInformation();	
+}
+
+//! changes the value of actual display status
+// input: up = 1 increment, up = 0 decrement
+void menuChangeValue(uint8_t up)
+{
+	switch(systemConfig.displayStatus)
+	{
+		// set hour manual
+		case DISPLAY_STATE_MENU_SET_HOUR:
+		{
+			if(up)
 			{
-				// ok switch is pressed
-				if(okSwitch)
+				// increment hour
+				setTime.hour++;
+				if(setTime.hour >= 24)
 				{
-					// set new display status: manual mode
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_MANUAL_MODE;
+					setTime.hour = 0;
 				}
-				// up or down switch is pressed
-				if(upSwitch || downSwitch)
-				{
-					// set new display status: set time ok blinking
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_MANUAL_OK;
-				}
-				// cancel switch is pressed
-				if(cancelSwitch)
-				{
-					// set new display status: manual mode
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_MANUAL_MODE;
-				}
-				break;
 			}
-			
-			// set time ok blinking
-			case DISPLAY_STATE_MENU_MANUAL_OK:
+			else
 			{
-				// ok switch is pressed
-				if(okSwitch)
-				{
-					// get time values from system time
-					setTime = systemTime;
-					// set new display status: set hour
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SET_HOUR;
-				}
-				// up or down switch is pressed
-				if(upSwitch || downSwitch)
+				// decrement hour
+				setTime.hour--;
+				if(setTime.hour >= 24)
 				{
-					// set new display status: set time cancel blinking
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_MANUAL_CANCEL;
+					setTime.hour = 23;
 				}
-				// cancel switch is pressed
-				if(cancelSwitch)
-				{
-					// set new display status: manual mode
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_MANUAL_MODE;
-				}
-				break;
-			}			
+			}
+			break;
+		}
 		
-			// set hour manual
-			case DISPLAY_STATE_MENU_SET_HOUR:
+		// set minute manual
+		case DISPLAY_STATE_MENU_SET_MINUTE:
+		{
+			if(up)
 			{
-				// ok switch is pressed
-				if(okSwitch)
+				// increment minute
+				setTime.minute++;
+				if(setTime.minute >= 60)
 				{
-					// set new display status: set minute
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SET_MINUTE;
-				}
-				// up switch is pressed
-				if(upSwitch)
-				{
-					// increment hour
+					setTime.minute = 0;
 					setTime.hour++;
 					if(setTime.hour >= 24)
 					{
 						setTime.hour = 0;
 					}
 				}
-				// down switch is pressed
-				if(downSwitch)
+			}
+			else
+			{
+				// decrement minute
+				setTime.minute--;
+				if(setTime.minute >= 60)
 				{
-					// decrement hour
+					setTime.minute = 59;
 					setTime.hour--;
 					if(setTime.hour >= 24)
 					{
 						setTime.hour = 23;
 					}
 				}
-				// cancel switch is pressed
-				if(cancelSwitch)
-				{
-					// set new display status: set cancel
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SET_CANCEL;
-				}
-				break;
 			}
+			break;
+		}
 		
-			// set minute manual
-			case DISPLAY_STATE_MENU_SET_MINUTE:
+		// set second manual
+		case DISPLAY_STATE_MENU_SET_SECOND:
+		{
+			if(up)
 			{
-				// ok switch is pressed
-				if(okSwitch)
-				{
-					// set new display status: set second
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SET_SECOND;
-				}
-				// up switch is pressed
-				if(upSwitch)
+				// increment second
+				setTime.second++;
+				if(setTime.second >= 60)
 				{
-					// increment minute
+					setTime.second = 0;
 					setTime.minute++;
 					if(setTime.minute >= 60)
 					{
@@ -330,10 +508,14 @@ void menuMgnt(uint8_t switches)
 						}
 					}
 				}
-				// down switch is pressed
-				if(downSwitch)
+			}
+			else
+			{
+				// decrement second
+				setTime.second--;
+				if(setTime.second >= 60)
 				{
-					// decrement minute
+					setTime.second = 59;
 					setTime.minute--;
 					if(setTime.minute >= 60)
 					{
@@ -345,147 +527,20 @@ void menuMgnt(uint8_t switches)
 						}
 					}
 				}
-				// cancel switch is pressed
-				if(cancelSwitch)
-				{
-					// set new display status: set hour
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SET_HOUR;
-				}
-				break;
-			}
-			
-			// set second manual
-			case DISPLAY_STATE_MENU_SET_SECOND:
-			{
-				// ok switch is pressed
-				if(okSwitch)
-				{
-					// set new display status: set day
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SET_DAY;
-				}
-				// up switch is pressed
-				if(upSwitch)
-				{
-					// increment second
-					setTime.second++;
-					if(setTime.second >= 60)
-					{
-						
-						setTime.second = 0;
-						setTime.minute++;
-						if(setTime.minute >= 60)
-						{
-							setTime.minute = 0;
-							setTime.hour++;
-							if(setTime.hour >= 24)
-							{
-								setTime.hour = 0;
-							}
-						}
-					}
-				}
-				// down switch is pressed
-				if(downSwitch)
-				{
-					// decrement second
-					setTime.second--;
-					if(setTime.second >= 60)
-					{
-						setTime.second = 59;
-						setTime.minute--;
-						if(setTime.minute >= 60)
-						{
-							setTime.minute = 59;
-							setTime.hour--;
-							if(setTime.hour >= 24)
-							{
-								setTime.hour = 23;
-							}
-						}
-					}
-				}
-				// cancel switch is pressed
-				if(cancelSwitch)
-				{
-					// set new display status: set minute
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SET_MINUTE;
-				}
-				break;
-			}		
-
-			// set day manual
-			case DISPLAY_STATE_MENU_SET_DAY:
-			{
-				// ok switch is pressed
-				if(okSwitch)
-				{
-					// set new display status: set month
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SET_MONTH;
-				}
-				// up switch is pressed
-				if(upSwitch)
-				{
-					// increment day
-					setTime.day++;
-					if(setTime.day >= 32)
-					{
-						
-						setTime.day = 1;
-						setTime.month++;
-						if(setTime.month >= 13)
-						{
-							setTime.month = 1;
-							setTime.year++;
-							if(setTime.year >= 100)
-							{
-								setTime.year = 0;
-							}
-						}
-					}
-				}
-				// down switch is pressed
-				if(downSwitch)
-				{
-					// decrement day
-					setTime.day--;
-					if(setTime.day <= 0)
-					{
-						setTime.day = 31;
-						setTime.month--;
-						if(setTime.month <= 0)
-						{
-							setTime.month = 12;
-							setTime.year--;
-							if(setTime.year <= 0)
-							{
-								setTime.year = 99;
-							}
-						}
-					}
-				}
-				// cancel switch is pressed
-				if(cancelSwitch)
-				{
-					// set new display status: set second
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SET_SECOND;
-				}
-				break;
 			}
-			
-
-			// set month manual
-			case DISPLAY_STATE_MENU_SET_MONTH:
+			break;
+		}
+		
+		// set day manual
+		case DISPLAY_STATE_MENU_SET_DAY:
+		{
+			if(up)
 			{
-				// ok switch is pressed
-				if(okSwitch)
-				{
-					// set new display status: set year
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SET_YEAR;
-				}
-				// up switch is pressed
-				if(upSwitch)
+				// increment day
+				setTime.day++;
+				if(setTime.day >= 32)
 				{
-					// increment month
+					setTime.day = 1;
 					setTime.month++;
 					if(setTime.month >= 13)
 					{
@@ -497,10 +552,14 @@ void menuMgnt(uint8_t switches)
 						}
 					}
 				}
-				// down switch is pressed
-				if(downSwitch)
+			}
+			else
+			{
+				// decrement day
+				setTime.day--;
+				if(setTime.day <= 0)
 				{
-					// decrement month
+					setTime.day = 31;
 					setTime.month--;
 					if(setTime.month <= 0)
 					{
@@ -508,648 +567,150 @@ void menuMgnt(uint8_t switches)
 						setTime.year--;
 						if(setTime.year <= 0)
 						{
-							setTime.year =99;
+							setTime.year = 99;
 						}
 					}
 				}
-				// cancel switch is pressed
-				if(cancelSwitch)
-				{
-					// set new display status: set day
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SET_DAY;
-				}
-				break;
-			}			
-			
-			// set year manual
-			case DISPLAY_STATE_MENU_SET_YEAR:
+			}
+			break;
+		}
+		
+		// set month manual
+		case DISPLAY_STATE_MENU_SET_MONTH:
+		{
+			if(up)
 			{
-				// ok switch is pressed
-				if(okSwitch)
-				{
-					// set new display status: set weekday
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SET_WEEKDAY;
-				}
-				// up switch is pressed
-				if(upSwitch)
+				// increment month
+				setTime.month++;
+				if(setTime.month >= 13)
 				{
-					// increment year
+					setTime.month = 1;
 					setTime.year++;
 					if(setTime.year >= 100)
 					{
 						setTime.year = 0;
 					}
 				}
-				// down switch is pressed
-				if(downSwitch)
+			}
+			else
+			{
+				// decrement month
+				setTime.month--;
+				if(setTime.month <= 0)
 				{
-					// decrement year
+					setTime.month = 12;
 					setTime.year--;
 					if(setTime.year <= 0)
 					{
 						setTime.year = 99;
 					}
 				}
-				// cancel switch is pressed
-				if(cancelSwitch)
-				{
-					// set new display status: set month
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SET_MONTH;
-				}
-				break;
 			}
-			
-			// set weekday manual
-			case DISPLAY_STATE_MENU_SET_WEEKDAY:
-			{
-				// ok switch is pressed
-				if(okSwitch)
-				{
-					// set new display status: set ok
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SET_OK;
-				}
-				// up switch is pressed
-				if(upSwitch)
-				{
-					// increment weekday
-					setTime.weekday++;
-					if(setTime.weekday >= 8)
-					{
-						setTime.weekday = 1;
-					}
-				}
-				// down switch is pressed
-				if(downSwitch)
-				{
-					// decrement weekday
-					setTime.weekday--;
-					if(setTime.weekday <= 0)
-					{
-						setTime.weekday = 7;
-					}
-				}
-				// cancel switch is pressed
-				if(cancelSwitch)
-				{
-					// set new display status: set year
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SET_YEAR;
-				}
-				break;
-			}			
-						
-			// set time cancel blinking
-			case DISPLAY_STATE_MENU_SET_CANCEL:
+			break;
+		}
+		
+		// set year manual
+		case DISPLAY_STATE_MENU_SET_YEAR:
+		{
+			if(up)
 			{
-				// ok switch is pressed
-				if(okSwitch)
-				{			
-					// set new display status: manual mode
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_MANUAL_MODE;
-				}
-				// up or down switch is pressed
-				if(upSwitch || downSwitch)
-				{
-					// set new display status: set time ok blinking
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SET_OK;
-				}
-				// cancel switch is pressed
-				if(cancelSwitch)
+				// increment year
+				setTime.year++;
+				if(setTime.year >= 100)
 				{
-					// set new display status: set hour
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SET_HOUR;
+					setTime.year = 0;
 				}
-				break;
 			}
-			
-			// set time ok blinking
-			case DISPLAY_STATE_MENU_SET_OK:
+			else
 			{
-				// ok switch is pressed
-				if(okSwitch)
-				{
-					// set actual manual time to system time
-					systemTime = setTime;
-					// set system status
-					// - xxxx.xxx1b time information in system available - a time signal is displayed (if no menu is selected)
-					// - xxx1.xxxb manual time mode is active
-					systemConfig.status |= 0x11;
-					// - xxxx.xx0xb searching for dcf77-signal is inactive
-					systemConfig.status &= ~0x02;
-					
-					// stop dcf77 signal
-					stopDcf77Signal();
-
-					// call menu cancel routine
-					menuCancel();
-				}
-				// up or down switch is pressed
-				if(upSwitch || downSwitch)
-				{
-					// set new display status: set time cancel blinking
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SET_CANCEL;
-				}
-				// cancel switch is pressed
-				if(cancelSwitch)
+				// decrement year
+				setTime.year--;
+				if(setTime.year <= 0)
 				{
-					// set new display status: set hour
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SET_HOUR;
+					setTime.year = 99;
 				}
-				break;
-			}
-		
-		// display settings		
-		case DISPLAY_STATE_MENU_SETTINGS:
-		{
-			// ok switch is pressed
-			if(okSwitch)
-			{
-				// set new display status: brightness
-				systemConfig.displayStatus = DISPLAY_STATE_MENU_BRIGTHNESS;
-			}
-			// up switch is pressed
-			if(upSwitch)
-			{
-				// set new display status: debug mode
-				systemConfig.displayStatus = DISPLAY_STATE_MENU_DBG;
-			}
-			// down switch is pressed
-			if(downSwitch)
-			{
-				// set new display status: time mode
-				systemConfig.displayStatus = DISPLAY_STATE_MENU_TIME_MODE;
-			}
-			// cancel switch is pressed
-			if(cancelSwitch)
-			{
-				// call menu cancel routine
-				menuCancel();	
 			}
 			break;
 		}
 		
-			// display settings: brightness
-			case DISPLAY_STATE_MENU_BRIGTHNESS:
+		// set weekday manual
+		case DISPLAY_STATE_MENU_SET_WEEKDAY:
+		{
+			if(up)
 			{
-				// ok switch is pressed
-				if(okSwitch)
-				{
-					// set new display status: 
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_BRIGHT_AUTO;
-				}
-				// up switch is pressed
-				if(upSwitch)
-				{
-					// set new display status: pie
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_PIE;
-				}
-				// down switch is pressed
-				if(downSwitch)
+				// increment weekday
+				setTime.weekday++;
+				if(setTime.weekday >= 8)
 				{
-					// set new display status: searching mode
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SEARCH_MODE;
+					setTime.weekday = 1;
 				}
-				// cancel switch is pressed
-				if(cancelSwitch)
-				{
-					// set new display status: display settings
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SETTINGS;
-				}
-				break;
 			}
-			
-				// display settings: brightness automatic mode
-				case DISPLAY_STATE_MENU_BRIGHT_AUTO:
-				{
-					// ok switch is pressed
-					if(okSwitch)
-					{
-						// set system display settings
-						// - x1xx.xxxxb automatic display brightness regulation is active
-						systemConfig.displaySetting |= 0x40; // see above
-						// set new display status: display settings brightness
-						systemConfig.displayStatus = DISPLAY_STATE_MENU_BRIGTHNESS;
-					}
-					// up or down switch is pressed
-					if(upSwitch || downSwitch)
-					{
-						// set new display status: manual mode
-						systemConfig.displayStatus = DISPLAY_STATE_MENU_BRIGHT_MANU;
-					}
-					// cancel switch is pressed
-					if(cancelSwitch)
-					{
-						// set new display status: display settings brightness
-						systemConfig.displayStatus = DISPLAY_STATE_MENU_BRIGTHNESS;
-					}
-					break;
-				}
-				
-				// display settings: brightness manual mode
-				case DISPLAY_STATE_MENU_BRIGHT_MANU:
-				{
-					// ok switch is pressed
-					if(okSwitch)
-					{
-						// set system display settings
-						// - x0xx.xxxxb automatic display brightness regulation is inactive
-						systemConfig.displaySetting &= ~0x40; // see above
-						// set new display status: display settings brightness
-						systemConfig.displayStatus = DISPLAY_STATE_MENU_BRIGTHNESS;
-					}
-					// up or down switch is pressed
-					if(upSwitch || downSwitch)
-					{
-						// set new display status: manual mode
-						systemConfig.displayStatus = DISPLAY_STATE_MENU_BRIGHT_AUTO;
-					}
-					// cancel switch is pressed
-					if(cancelSwitch)
-					{
-						// set new display status: display settings brightness
-						systemConfig.displayStatus = DISPLAY_STATE_MENU_BRIGTHNESS;
-					}
-					break;
-				}				
-			
-			// display settings: pie
-			case DISPLAY_STATE_MENU_PIE:
+			else
 			{
-				// ok switch is pressed
-				if(okSwitch)
+				// decrement weekday
+				setTime.weekday--;
+				if(setTime.weekday <= 0)
 				{
-					// set new display status:
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_PIE_STRAIGHT;
+					setTime.weekday = 7;
 				}
-				// up switch is pressed
-				if(upSwitch)
-				{
-					// set new display status: character variant
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_CHAR;
-				}
-				// down switch is pressed
-				if(downSwitch)
-				{
-					// set new display status: brightness
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_BRIGTHNESS;
-				}
-				// cancel switch is pressed
-				if(cancelSwitch)
-				{
-					// set new display status: display settings
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SETTINGS;
-				}
-				break;
 			}
-			
-				// display settings: pie straight
-				case DISPLAY_STATE_MENU_PIE_STRAIGHT:
-				{
-					// ok switch is pressed
-					if(okSwitch)
-					{
-						// set system display settings
-						// - xxxx.xxx0b original straight pie
-						systemConfig.displaySetting &= ~0x01; // see above
-						// set new display status: display settings pie
-						systemConfig.displayStatus = DISPLAY_STATE_MENU_PIE;
-					}
-					// up or down switch is pressed
-					if(upSwitch || downSwitch)
-					{
-						// set new display status: shift pie
-						systemConfig.displayStatus = DISPLAY_STATE_MENU_PIE_SHIFT;
-					}
-					// cancel switch is pressed
-					if(cancelSwitch)
-					{
-						// set new display status: display settings pie
-						systemConfig.displayStatus = DISPLAY_STATE_MENU_PIE;
-					}
-					break;
-				}
-				
-				// display settings: pie shift
-				case DISPLAY_STATE_MENU_PIE_SHIFT:
-				{
-					// ok switch is pressed
-					if(okSwitch)
-					{
-						// set system display settings
-						// - xxxx.xxx1b shifted pie (for 2 minutes)
-						systemConfig.displaySetting |= 0x01; // see above
-						// set new display status: display settings pie
-						systemConfig.displayStatus = DISPLAY_STATE_MENU_PIE;
-					}
-					// up or down switch is pressed
-					if(upSwitch || downSwitch)
-					{
-						// set new display status: straight pie
-						systemConfig.displayStatus = DISPLAY_STATE_MENU_PIE_STRAIGHT;
-					}
-					// cancel switch is pressed
-					if(cancelSwitch)
-					{
-						// set new display status: display settings pie
-						systemConfig.displayStatus = DISPLAY_STATE_MENU_PIE;
-					}
-					break;
-				}			
-			
-			// display settings: character variant
-			case DISPLAY_STATE_MENU_CHAR:
+			break;
+		}
+		
+		// manual display brightness (saturated)
+		case DISPLAY_STATE_MENU_BRIGHT_VALUE:
+		{
+			if(up)
 			{
-				// ok switch is pressed
-				if(okSwitch)
-				{
-					// set new display status: character variant standard
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_CHAR_STANDARD;
-				}
-				// up switch is pressed
-				if(upSwitch)
-				{
-					// set new display status: searching sequence
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SEARCH_MODE;
-				}
-				// down switch is pressed
-				if(downSwitch)
+				if(systemConfig.manualBrightness <= 255 - MENU_BRIGHTNESS_STEP)
 				{
-					// set new display status: pie
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_PIE;
+					systemConfig.manualBrightness += MENU_BRIGHTNESS_STEP;
 				}
-				// cancel switch is pressed
-				if(cancelSwitch)
+				else
 				{
-					// set new display status: display settings
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SETTINGS;
+					systemConfig.manualBrightness = 255;
 				}
-				break;
 			}
-			
-				// display settings: character variant standard
-				case DISPLAY_STATE_MENU_CHAR_STANDARD:
-				{
-					// ok switch is pressed
-					if(okSwitch)
-					{
-						// set system display settings
-						// - xxxx.000xb standard without birthday and horse information
-						systemConfig.displaySetting &= ~0x0E; // see above
-						// set new display status: display settings character variant
-						systemConfig.displayStatus = DISPLAY_STATE_MENU_CHAR;
-					}
-					// up or down switch is pressed
-					if(upSwitch || downSwitch)
-					{
-						// set new display status: character variant birthday & horses
-						systemConfig.displayStatus = DISPLAY_STATE_MENU_CHAR_BIRTHDAY;
-					}
-					// cancel switch is pressed
-					if(cancelSwitch)
-					{
-						// set new display status: display settings character variant
-						systemConfig.displayStatus = DISPLAY_STATE_MENU_CHAR;
-					}
-					break;
-				}	
-				
-				// display settings: character variant birthday & horses
-				case DISPLAY_STATE_MENU_CHAR_BIRTHDAY:
-				{
-					// ok switch is pressed
-					if(okSwitch)
-					{
-						// set system display settings
-						// - xxxx.001xb birthday (01.01., 16.01., 07.08., 22.09., 08.12.) and horses@6pm
-						systemConfig.displaySetting |= 0x02; // see above
-						// set new display status: display settings character variant
-						systemConfig.displayStatus = DISPLAY_STATE_MENU_CHAR;
-					}
-					// up or down switch is pressed
-					if(upSwitch || downSwitch)
-					{
-						// set new display status: character variant birthday & horses
-						systemConfig.displayStatus = DISPLAY_STATE_MENU_CHAR_STANDARD;
-					}
-					// cancel switch is pressed
-					if(cancelSwitch)
-					{
-						// set new display status: display settings character variant
-						systemConfig.displayStatus = DISPLAY_STATE_MENU_CHAR;
-					}
-					break;
-				}					
-			
-			// display settings: searching sequence
-			case DISPLAY_STATE_MENU_SEARCH_MODE:
+			else
 			{
-				// ok switch is pressed
-				if(okSwitch)
+				if(systemConfig.manualBrightness >= MENU_BRIGHTNESS_STEP)
 				{
-					// set new display status: no searching sequence
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SEARCH_NO;
+					systemConfig.manualBrightness -= MENU_BRIGHTNESS_STEP;
 				}
-				// up switch is pressed
-				if(upSwitch)
+				else
 				{
-					// set new display status: brightness
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_BRIGTHNESS;
+					systemConfig.manualBrightness = 0;
 				}
-				// down switch is pressed
-				if(downSwitch)
-				{
-					// set new display status: character variant
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_CHAR;
-				}
-				// cancel switch is pressed
-				if(cancelSwitch)
-				{
-					// set new display status: display settings
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_SETTINGS;
-				}
-				break;
-			}	
-			
-				// display settings: no searching sequence
-				case DISPLAY_STATE_MENU_SEARCH_NO:
-				{
-					// ok switch is pressed
-					if(okSwitch)
-					{
-						// set system display settings
-						// - 1xxx.xxxxb set's the display sequence while time searching mode - no sequence
-						systemConfig.displaySetting |= 0x80; // see above
-						// set new display status: display settings searching sequence
-						systemConfig.displayStatus = DISPLAY_STATE_MENU_SEARCH_MODE;
-					}
-					// up or down switch is pressed
-					if(upSwitch || downSwitch)
-					{
-						// set new display status: searching sequence square
-						systemConfig.displayStatus = DISPLAY_STATE_MENU_SEARCH_SQUARE;
-					}
-					// cancel switch is pressed
-					if(cancelSwitch)
-					{
-						// set new display status: display settings searching sequence
-						systemConfig.displayStatus = DISPLAY_STATE_MENU_SEARCH_MODE;
-					}
-					break;
-				}								
-				
-				// display settings: searching sequence square
-				case DISPLAY_STATE_MENU_SEARCH_SQUARE:
-				{
-					// ok switch is pressed
-					if(okSwitch)
-					{
-						// set system display settings
-						// - 0xxx.xxxxb set's the display sequence while time searching mode - square
-						systemConfig.displaySetting &= ~0x80; // see above
-						// set new display status: display settings searching sequence
-						systemConfig.displayStatus = DISPLAY_STATE_MENU_SEARCH_MODE;
-					}
-					// up or down switch is pressed
-					if(upSwitch || downSwitch)
-					{
-						// set new display status: no searching sequence
-						systemConfig.displayStatus = DISPLAY_STATE_MENU_SEARCH_NO;
-					}
-					// cancel switch is pressed
-					if(cancelSwitch)
-					{
-						// set new display status: display settings searching sequence
-						systemConfig.displayStatus = DISPLAY_STATE_MENU_SEARCH_MODE;
-					}
-					break;
-				}				
-				
-		// debug mode
-		case DISPLAY_STATE_MENU_DBG:
-		{
-			// ok switch is pressed
-			if(okSwitch)
-			{
-				// set new display status: debug mode 1
-				systemConfig.displayStatus = DISPLAY_STATE_MENU_DBG1;
-			}
-			// up switch is pressed
-			if(upSwitch)
-			{
-				// set new display status: show version
-				systemConfig.displayStatus = DISPLAY_STATE_MENU_VERSION;
-			}
-			// down switch is pressed
-			if(downSwitch)
-			{
-				// set new display status: display settings		
-				systemConfig.displayStatus = DISPLAY_STATE_MENU_SETTINGS;
-			}
-			// cancel switch is pressed
-			if(cancelSwitch)
-			{
-				// call menu cancel routine
-				menuCancel();
 			}
 			break;
 		}
-			
-			// debug mode 1
-			case DISPLAY_STATE_MENU_DBG1:
+		
+		// shift of pie in minutes (1 to PIE_SHIFT_MAXIMUM)
+		case DISPLAY_STATE_MENU_PIE_MINUTES:
+		{
+			if(up)
 			{
-				// ok switch is pressed
-				if(okSwitch)
-				{
-					// do nothing
-				}
-				// up switch is pressed
-				if(upSwitch)
-				{
-					// set new display status: debug mode 2
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_DBG2;
-				}
-				// down switch is pressed
-				if(downSwitch)
+				if(systemConfig.pieShift < PIE_SHIFT_MAXIMUM)
 				{
-					// set new display status: debug mode 3
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_DBG3;
-				}				
-				// cancel switch is pressed
-				if(cancelSwitch)
-				{
-					// set new display status: debug mode 
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_DBG;
+					systemConfig.pieShift++;
 				}
-				break;
 			}
-			
-			// debug mode 2
-			case DISPLAY_STATE_MENU_DBG2:
+			else
 			{
-				// ok switch is pressed
-				if(okSwitch)
-				{
-					// do nothing
-				}
-				// up switch is pressed
-				if(upSwitch)
-				{
-					// set new display status: debug mode 3
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_DBG3;
-				}
-				// down switch is pressed
-				if(downSwitch)
+				if(systemConfig.pieShift > 1)
 				{
-					// set new display status: debug mode 1
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_DBG1;
+					systemConfig.pieShift--;
 				}
-				// cancel switch is pressed
-				if(cancelSwitch)
-				{
-					// set new display status: debug mode
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_DBG;
-				}
-				break;
 			}
+			break;
+		}
 		
-			// debug mode 3
-			case DISPLAY_STATE_MENU_DBG3:
-			{
-				// ok switch is pressed
-				if(okSwitch)
-				{
-					// do nothing
-				}
-				// up switch is pressed
-				if(upSwitch)
-				{
-					// set new display status: debug mode 1
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_DBG1;
-				}
-				// down switch is pressed
-				if(downSwitch)
-				{
-					// set new display status: debug mode 2
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_DBG2;
-				}
-				// cancel switch is pressed
-				if(cancelSwitch)
-				{
-					// set new display status: debug mode
-					systemConfig.displayStatus = DISPLAY_STATE_MENU_DBG;
-				}
-				break;
-			}		
-		
-		// out of state? return to default state
+		// no value
 		default:
 		{
-			// do nothing
 			break;
-		}	
+		}
 	}
-	
-	// actualize matrix information, called by switch
-	displayMatrixInformation(1);	
 }
 
 //! routine when we're leaving menu
@@ -1160,7 +721,34 @@ void menuCancel(void)
 	systemConfig.status &= ~0x08;
 	// set new display status
 	systemConfig.displayStatus = DISPLAY_STATE_DARK;
+	
+	// save changed settings
+	saveConfig();
 					
 	// actualize matrix information
-	displayMatrixInformation(0);
+	displayMatrixInformation();
+}
+
+//! Take manual time ('setTime') as system time and rtc time, stops dcf77
+// reception, called by menu and console
+void storeManualTime(void)
+{
+	// set actual manual time to system time (time management isr is running)
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		systemTime = setTime;
+	}
+	// set system status
+	// - xxxx.xxx1b time information in system available - a time signal is displayed (if no menu is selected)
+	// - xxx1.xxxb manual time mode is active
+	systemConfig.status |= 0x11;
+	// - xxxx.xx0xb searching for dcf77-signal is inactive
+	systemConfig.status &= ~0x02;
+	
+	// stop dcf77 signal
+	stopDcf77Signal();
+	logEvent(LOG_EVENT_MANUAL_TIME, 0);
+	
+	// write manual time to rtc (at next second tick)
+	requestRtcWrite();
 }
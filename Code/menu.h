@@ -13,8 +13,43 @@
 
 //! libraries
 #include <avr/io.h>
+#include <util/atomic.h>
 #include <stdint.h>
 
+//! transition of menu state machine (see menuTransitions in menu.c)
+struct menuTransition
+{
+	uint8_t state;		// actual display status
+	uint8_t switches;	// pressed switches of event (one of them)
+	uint8_t next;		// next display status
+	uint8_t action;		// action of transition
+	uint8_t parameter;	// parameter of action (bits of display settings)
+};
+
 //! Functional prototypes
+void initMenu(void);
+void menuSwitchEvent(uint8_t switches);
+void menuLongPressEvent(uint8_t switches);
 void menuMgnt(uint8_t switches);
-void menuCancel(void);
\ No newline at end of file
+void menuChangeValue(uint8_t up);
+void menuCancel(void);
+void storeManualTime(void);
+
+//! Index of transitions: menu states DISPLAY_STATE_MENU_VERSION to 255 and
+// number of transitions (max. 255)
+#define MENU_STATES					(256 - DISPLAY_STATE_MENU_VERSION)
+#define MENU_TRANSITIONS			(sizeof(menuTransitions) / sizeof(menuTransitions[0]))
+
+//! Actions of menu transitions
+#define MENU_ACTION_NONE			0	// only new display status
+#define MENU_ACTION_EXIT			1	// leave menu
+#define MENU_ACTION_START_DCF		2	// search automatic dcf77 time, leave menu
+#define MENU_ACTION_LOAD_TIME		3	// get system time to set manual
+#define MENU_ACTION_STORE_TIME		4	// take manual time, leave menu
+#define MENU_ACTION_INCREMENT		5	// increment value of display status
+#define MENU_ACTION_DECREMENT		6	// decrement value of display status
+#define MENU_ACTION_SET_SETTING		7	// set bits of display settings
+#define MENU_ACTION_CLEAR_SETTING	8	// clear bits of display settings
+#define MENU_ACTION_PROFILE_NEXT	9	// select next profiled task
+#define MENU_ACTION_PROFILE_DUMP	10	// send task profiles via console
+#define MENU_ACTION_LOG_DUMP		11	// send event log via console
\ No newline at end of file
@@ -0,0 +1,190 @@
+/*******************************************************************************
+*
+*	Author:			Georg Bauer
+*	Date:			18.10.2026
+*
+*	Project-Title:	ClockWise
+*	Description:	Night schedule of the led matrix
+*
+*	File-Title:		Night Management
+*
+*******************************************************************************
+*
+* Night schedule:
+*	Between start and end time (end time can be after midnight) of the
+*	selected weekdays the matrix is switched to night mode:
+*	- NIGHT_MODE_BLANK: timer 2 is stopped and !LEDEN is hold high
+*	- NIGHT_MODE_DIM: timer 2 keeps its clock and runs with the minimum pwm
+*	  value, NIGHT_DIM_FRAME_SKIP frames after every frame are skipped (less
+*	  isr load, 1 gives about 40Hz per frame)
+*	Every switch wakes the display for NIGHT_WAKE_TIME seconds, this switch
+*	is not passed to the menu. Night mode is only active, when a time
+*	information is available and the menu is inactive.
+*
+*	Weekdays (variable "weekdays"): bit 0 monday ... bit 6 sunday, the day
+*	is the day of the start time.
+*
+*******************************************************************************
+*/
+
+//! Libraries
+#include "nightMgnt.h"
+#include "settings.h"
+#include "system.h"
+#include "ledMatrix.h"
+
+//! Own global variables
+// schedule of night mode
+struct nightSchedule nightSchedule;
+// actual state of night mode (see defines)
+uint8_t nightState;
+// seconds until display sleeps again
+uint8_t nightWakeCounter;
+
+//! Extern global variables
+extern volatile struct systemParameter systemConfig;
+extern volatile struct time systemTime;
+
+//! Initialize night management with default schedule
+void initNightMgnt(void)
+{
+	nightSchedule.start		= NIGHT_START_HOUR * 60 + NIGHT_START_MINUTE;
+	nightSchedule.end		= NIGHT_END_HOUR * 60 + NIGHT_END_MINUTE;
+	nightSchedule.weekdays	= NIGHT_WEEKDAYS;
+	nightSchedule.mode		= NIGHT_MODE;
+	
+	nightState = NIGHT_STATE_DAY;
+	nightWakeCounter = 0;
+}
+
+//! Check if the actual time is in the night schedule
+uint8_t isNightTime(void)
+{
+	uint16_t minuteOfDay = 0;
+	uint8_t weekday = 0;
+	
+	// time is changed by the second interrupt
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		minuteOfDay = systemTime.hour * 60 + systemTime.minute;
+		weekday = systemTime.weekday;
+	}
+	
+	// no schedule
+	if((nightSchedule.mode == NIGHT_MODE_OFF) || (nightSchedule.start == nightSchedule.end))
+	{
+		return 0;
+	}
+	
+	// no valid weekday (no time received yet)
+	if((weekday < 1) || (weekday > 7))
+	{
+		return 0;
+	}
+	
+	// night within one day (e.g. 01:00 to 05:00)
+	if(nightSchedule.start < nightSchedule.end)
+	{
+		if((minuteOfDay < nightSchedule.start) || (minuteOfDay >= nightSchedule.end))
+		{
+			return 0;
+		}
+	}
+	// night over midnight (e.g. 23:00 to 06:00)
+	else
+	{
+		if((minuteOfDay < nightSchedule.start) && (minuteOfDay >= nightSchedule.end))
+		{
+			return 0;
+		}
+		// after midnight: the night started on the day before
+		if(minuteOfDay < nightSchedule.end)
+		{
+			weekday--;
+			if(weekday < 1)
+			{
+				weekday = 7;
+			}
+		}
+	}
+	
+	// weekday is selected (1 monday to 7 sunday)
+	return (nightSchedule.weekdays >> (weekday - 1)) & 0x01;
+}
+
+//! Check night schedule and switch matrix, called by second task
+void checkNightMgnt(void)
+{
+	uint8_t newState = NIGHT_STATE_DAY;
+	
+	// display is woken up by a switch
+	if(nightWakeCounter)
+	{
+		nightWakeCounter--;
+	}
+	
+	// night mode only with time information and without menu
+	if((systemConfig.status & 0x01) && !(systemConfig.status & 0x08) && !nightWakeCounter && isNightTime())
+	{
+		if(nightSchedule.mode == NIGHT_MODE_DIM)
+		{
+			newState = NIGHT_STATE_DIM;
+		}
+		else
+		{
+			newState = NIGHT_STATE_BLANK;
+		}
+	}
+	
+	// no change
+	if(newState == nightState)
+	{
+		return;
+	}
+	nightState = newState;
+	
+	switch(nightState)
+	{
+		case NIGHT_STATE_BLANK:
+			// stop multiplexing
+			stopMatrix();
+			break;
+		case NIGHT_STATE_DIM:
+			// multiplexing with skipped frames and minimum pwm value (see brightness.c)
+			setMatrixFrameSkip(NIGHT_DIM_FRAME_SKIP);
+			startMatrix();
+			break;
+		default:
+			// normal multiplexing
+			setMatrixFrameSkip(0);
+			startMatrix();
+			break;
+	}
+}
+
+//! Wake display, called by switch event
+// output: 1 if the display was in night mode (switch is used for wake up only)
+uint8_t wakeNightMgnt(void)
+{
+	uint8_t sleeping = (nightState != NIGHT_STATE_DAY);
+	
+	// keep display awake (also while it is awake already)
+	if(sleeping || nightWakeCounter)
+	{
+		nightWakeCounter = NIGHT_WAKE_TIME;
+	}
+	
+	if(sleeping)
+	{
+		nightState = NIGHT_STATE_DAY;
+		setMatrixFrameSkip(0);
+		startMatrix();
+	}
+	return sleeping;
+}
+
+//! Get actual state of night mode
+uint8_t getNightState(void)
+{
+	return nightState;
+}
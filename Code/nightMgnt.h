@@ -0,0 +1,43 @@
+/*******************************************************************************
+*
+*	Author:			Georg Bauer
+*	Date:			18.10.2026
+*
+*	Project-Title:	ClockWise
+*	Description:	Night schedule of the led matrix
+*
+*	File-Title:		Night Management - Header File
+*
+*******************************************************************************
+*/
+
+//! Libraries
+#include <avr/io.h>
+#include <util/atomic.h>
+#include <stdint.h>
+
+//! Night Schedule Structure
+struct nightSchedule
+{
+	uint16_t start;		// start time in minutes of day (0 to 1439)
+	uint16_t end;		// end time in minutes of day (0 to 1439)
+	uint8_t weekdays;	// days of start time, bit 0 monday to bit 6 sunday
+	uint8_t mode;		// night mode, see defines below
+};
+
+//! Functional prototypes
+void initNightMgnt(void);
+uint8_t isNightTime(void);
+void checkNightMgnt(void);
+uint8_t wakeNightMgnt(void);
+uint8_t getNightState(void);
+
+//! Night Mode (schedule)
+#define NIGHT_MODE_OFF				0	// no night mode
+#define NIGHT_MODE_BLANK			1	// matrix is dark, multiplexing is stopped
+#define NIGHT_MODE_DIM				2	// matrix is deep dimmed, minimum pwm value
+
+//! Night State (actual)
+#define NIGHT_STATE_DAY				0	// normal display
+#define NIGHT_STATE_BLANK			1	// matrix is dark
+#define NIGHT_STATE_DIM				2	// matrix is deep dimmed
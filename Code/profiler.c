@@ -0,0 +1,217 @@
+/*******************************************************************************
+*
+*	Author:			Georg Bauer
+*	Date:			18.10.2026
+*
+*	Project-Title:	ClockWise
+*	Description:	Execution time and latency of tasks
+*
+*	File-Title:		Task Profiler
+*
+*******************************************************************************
+*
+* Every dispatch of a task is timestamped with the free running timer 3. For
+* every task the minimum, maximum and mean run time, the latency between
+* setting the task flag (calculateTaskTiming) and dispatching the task and
+* the number of overruns (task flag set again, while the task was still
+* pending) is recorded.
+*
+* The results are shown in the debug menu and sent via usart 0.
+* The profiler is only compiled, if TASK_PROFILING is defined (settings.h).
+*
+*******************************************************************************
+*
+*	Timer:
+*	Timer 3 is free running with prescaler 64 -> 4us per tick, overflow 262ms
+*	(started by the button driver, see buttons.c)
+*
+*******************************************************************************
+*/
+
+//! Libraries
+#include "profiler.h"
+#include "usart.h"
+
+#ifdef TASK_PROFILING
+
+//! Profile of one task
+struct profile
+{
+	uint16_t runMin;		// minimum run time
+	uint16_t runMax;		// maximum run time
+	uint32_t runSum;		// sum of all run times
+	uint16_t runCount;		// number of runs
+	uint16_t latencyMax;	// maximum latency
+	uint32_t latencySum;	// sum of all latencies
+	uint16_t overruns;		// number of overruns
+	uint16_t requestStamp;	// timestamp of last request
+	uint16_t beginStamp;	// timestamp of actual run
+	uint8_t pending;		// request is pending
+};
+
+//! Own global variables
+struct profile profiles[PROFILE_COUNT];
+uint8_t profileSelection;
+
+//! Initialize profiler
+void initProfiler(void)
+{
+	uint8_t i = 0;
+
+	// free running timer 3 for timestamps is started by initButtons()
+
+	// reset all profiles
+	for(i = 0; i < PROFILE_COUNT; i++)
+	{
+		profiles[i].runMin = 0xFFFF;
+		profiles[i].runMax = 0;
+		profiles[i].runSum = 0;
+		profiles[i].runCount = 0;
+		profiles[i].latencyMax = 0;
+		profiles[i].latencySum = 0;
+		profiles[i].overruns = 0;
+		profiles[i].pending = 0;
+	}
+	profileSelection = 0;
+}
+
+//! Task flags are set by task timing
+// input: new task flags, bit 0 to 7 are equal to profiled tasks 0 to 7
+void profileRequest(uint8_t taskFlags)
+{
+	uint8_t i = 0;
+	uint16_t stamp = TCNT3;
+
+	for(i = 0; i < 8; i++)
+	{
+		if(taskFlags & (1 << i))
+		{
+			// task is still pending: overrun
+			if(profiles[i].pending)
+			{
+				profiles[i].overruns++;
+			}
+			else
+			{
+				profiles[i].requestStamp = stamp;
+				profiles[i].pending = 1;
+			}
+		}
+	}
+}
+
+//! Task is dispatched
+void profileBegin(uint8_t id)
+{
+	uint16_t latency;
+
+	profiles[id].beginStamp = TCNT3;
+
+	// latency between request and dispatch
+	if(profiles[id].pending)
+	{
+		profiles[id].pending = 0;
+		latency = profiles[id].beginStamp - profiles[id].requestStamp;
+		if(latency > profiles[id].latencyMax)
+		{
+			profiles[id].latencyMax = latency;
+		}
+		profiles[id].latencySum += latency;
+	}
+}
+
+//! Task is finished
+void profileEnd(uint8_t id)
+{
+	uint16_t runTime = TCNT3 - profiles[id].beginStamp;
+
+	if(runTime < profiles[id].runMin)
+	{
+		profiles[id].runMin = runTime;
+	}
+	if(runTime > profiles[id].runMax)
+	{
+		profiles[id].runMax = runTime;
+	}
+	profiles[id].runSum += runTime;
+	profiles[id].runCount++;
+
+	// restart mean calculation before the counter overflows
+	if(profiles[id].runCount == 0xFFFF)
+	{
+		profiles[id].runSum = 0;
+		profiles[id].latencySum = 0;
+		profiles[id].runCount = 0;
+	}
+}
+
+//! Select next task for debug menu
+void profileSelectNext(void)
+{
+	profileSelection++;
+	if(profileSelection >= PROFILE_COUNT)
+	{
+		profileSelection = 0;
+	}
+}
+
+//! Get selected task for debug menu
+uint8_t getProfileSelection(void)
+{
+	return profileSelection;
+}
+
+//! Get a profile value of a task
+// input: profiled task and profile value (see profiler.h)
+uint16_t getProfileValue(uint8_t id, uint8_t value)
+{
+	switch(value)
+	{
+		case PROFILE_RUN_MIN:
+			if(profiles[id].runCount == 0)
+			{
+				return 0;
+			}
+			return profiles[id].runMin;
+		case PROFILE_RUN_MAX:
+			return profiles[id].runMax;
+		case PROFILE_RUN_MEAN:
+			if(profiles[id].runCount == 0)
+			{
+				return 0;
+			}
+			return profiles[id].runSum / profiles[id].runCount;
+		case PROFILE_LATENCY_MAX:
+			return profiles[id].latencyMax;
+		case PROFILE_LATENCY_MEAN:
+			if(profiles[id].runCount == 0)
+			{
+				return 0;
+			}
+			return profiles[id].latencySum / profiles[id].runCount;
+		case PROFILE_OVERRUNS:
+			return profiles[id].overruns;
+		default:
+			return 0;
+	}
+}
+
+//! Send profile of one task via usart 0 in one line:
+// id min max mean latency-max latency-mean overruns
+// (hexadecimal values, times in 4us ticks, 34 characters)
+void profileDump(uint8_t task)
+{
+	uint8_t value = 0;
+
+	usart0TransmitHex(task);
+	for(value = PROFILE_RUN_MIN; value <= PROFILE_OVERRUNS; value++)
+	{
+		usart0Transmit(' ');
+		usart0TransmitHex(getProfileValue(task, value) >> 8);
+		usart0TransmitHex(getProfileValue(task, value));
+	}
+	usart0Transmit('\r');
+	usart0Transmit('\n');
+}
+
+#endif
@@ -0,0 +1,59 @@
+/*******************************************************************************
+*
+*	Author:			Georg Bauer
+*	Date:			18.10.2026
+*
+*	Project-Title:	ClockWise
+*	Description:	Execution time and latency of tasks
+*
+*	File-Title:		Task Profiler - Header File
+*
+*******************************************************************************
+*/
+
+//! Libraries
+#include <avr/io.h>
+#include <stdint.h>
+#include "settings.h"
+
+//! Functional prototypes
+void initProfiler(void);
+void profileRequest(uint8_t taskFlags);
+void profileBegin(uint8_t id);
+void profileEnd(uint8_t id);
+void profileSelectNext(void);
+uint8_t getProfileSelection(void);
+uint16_t getProfileValue(uint8_t id, uint8_t value);
+void profileDump(uint8_t task);
+
+//! Profiled tasks (0 to 7 are equal to the bits of the task flags)
+#define PROFILE_TASK_HALF_SECOND	0	// half second task
+#define PROFILE_TASK_SECOND			1	// second task
+#define PROFILE_TASK_MINUTE			2	// minute task
+#define PROFILE_TASK_FIVE_MINUTE	3	// 5-minute task
+#define PROFILE_TASK_TEN_MINUTE		4	// 10-minute task
+#define PROFILE_TASK_FIFTEEN_MINUTE	5	// 15-minute task
+#define PROFILE_TASK_THIRTY_MINUTE	6	// 30-minute task
+#define PROFILE_TASK_HOUR			7	// hour task
+#define PROFILE_DISPLAY				8	// displayMatrixInformation()
+#define PROFILE_MENU				9	// menu management
+#define PROFILE_COUNT				10	// number of profiled tasks
+
+//! Profile values (times in timer 3 ticks of 4us)
+#define PROFILE_RUN_MIN				0	// minimum run time
+#define PROFILE_RUN_MAX				1	// maximum run time
+#define PROFILE_RUN_MEAN			2	// mean run time
+#define PROFILE_LATENCY_MAX			3	// maximum latency between request and dispatch
+#define PROFILE_LATENCY_MEAN		4	// mean latency between request and dispatch
+#define PROFILE_OVERRUNS			5	// requests while task was still pending
+
+//! Profiling macros, empty if profiling is disabled (see settings.h)
+#ifdef TASK_PROFILING
+#define PROFILE_REQUEST(flags)		profileRequest(flags)
+#define PROFILE_BEGIN(id)			profileBegin(id)
+#define PROFILE_END(id)				profileEnd(id)
+#else
+#define PROFILE_REQUEST(flags)
+#define PROFILE_BEGIN(id)
+#define PROFILE_END(id)
+#endif
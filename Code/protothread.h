@@ -0,0 +1,76 @@
+/*******************************************************************************
+*
+*	Author:			Georg Bauer
+*	Date:			18.10.2026
+*
+*	Project-Title:	ClockWise
+*	Description:	Stackless coroutines (protothreads) for multi-step sequences
+*
+*	File-Title:		Protothreads - Header File
+*
+*******************************************************************************
+*
+* A thread is a function returning uint8_t, which is called by the scheduler
+* in every pass of the main loop (see checkForThreads() in taskMgnt.c). The
+* position of the thread is saved in its 'struct pt' as a line number, a
+* thread continues behind the last PT_YIELD, PT_WAIT_UNTIL or PT_SLEEP_MS.
+*
+* Rules:
+* - local variables are lost at every wait, use static variables instead
+* - no switch statement between PT_BEGIN and PT_END (Duff's device)
+* - maximum sleep time is 32767 system ticks (about 536s)
+*
+* Example:
+*	uint8_t threadExample(void)
+*	{
+*		static struct pt pt;
+*		PT_BEGIN(&pt);
+*		while(1)
+*		{
+*			PT_WAIT_UNTIL(&pt, condition);
+*			doSomething();
+*			PT_SLEEP_MS(&pt, 500);
+*		}
+*		PT_END(&pt);
+*	}
+*
+*******************************************************************************
+*/
+
+//! Libraries
+#include <stdint.h>
+#include "timeMgnt.h"
+
+//! Protothread Structure
+struct pt
+{
+	uint16_t lc;		// local continuation: line of last wait, 0 at start
+	uint16_t wakeup;	// system tick to wake up after PT_SLEEP_MS
+};
+
+//! Thread State (return value of a thread)
+#define PT_WAITING					0	// thread waits for a condition
+#define PT_YIELDED					1	// thread gives up the cpu for one pass
+#define PT_ENDED					2	// thread reached PT_END and starts again
+
+//! Conversion from milliseconds to system ticks (timer 0, 16,384ms), rounded up
+#define PT_MS_TO_TICKS(ms)			((uint16_t)(((uint32_t)(ms) * 125 + 2047) / 2048))
+
+//! Initialize thread, starts at PT_BEGIN
+#define PT_INIT(pt)					(pt)->lc = 0
+
+//! Begin of thread, continue at last position
+#define PT_BEGIN(pt)				switch((pt)->lc) { case 0:
+
+//! End of thread, restart at PT_BEGIN on next call
+#define PT_END(pt)					} (pt)->lc = 0; return PT_ENDED
+
+//! Give up the cpu for one pass of the main loop
+#define PT_YIELD(pt)				do { (pt)->lc = __LINE__; return PT_YIELDED; case __LINE__:; } while(0)
+
+//! Wait until condition is true, condition is checked in every pass
+#define PT_WAIT_UNTIL(pt, cond)		do { (pt)->lc = __LINE__; case __LINE__: if(!(cond)) return PT_WAITING; } while(0)
+
+//! Sleep for a time in milliseconds (resolution of system tick)
+#define PT_SLEEP_MS(pt, ms)			do { (pt)->wakeup = getSystemTicks() + PT_MS_TO_TICKS(ms); \
+										PT_WAIT_UNTIL(pt, (int16_t)(getSystemTicks() - (pt)->wakeup) >= 0); } while(0)
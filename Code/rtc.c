@@ -9,38 +9,617 @@
 *	File-Title:		Real Time Clock (DS 1307)
 *
 *******************************************************************************
+*
+* Pin Declaration:
+*	Pin						| Description
+*	------------------------|-------------------------------------------------
+*	PC0 (Pin 22) as SCL		| TWI clock, 100kHz (DS1307 maximum)
+*	PC1 (Pin 23) as SDA		| TWI data
+*	------------------------|-------------------------------------------------
+*
+*******************************************************************************
+*
+*	Interrupts:
+*	The TWI interrupt drives a transaction: start, slave address, register
+*	pointer and a burst of data bytes (write) or a repeated start, slave
+*	address and a burst of data bytes (read). A transaction never blocks the
+*	main loop, its end is published with event EVENT_RTC (data: operation,
+*	first register and RTC_ERROR), so a queued event is decoded with its own
+*	transaction. A failed transaction (nack, lost arbitration, bus error) is
+*	started again up to RTC_RETRIES times. A transaction without end
+*	(hanging bus) is aborted by rtcTick() after RTC_TIMEOUT. Bus errors and
+*	retries are counted (saturated).
+*
+*	The time registers 0 to 6 are read as burst and decoded from BCD by
+*	decodeRtc() in the main loop. No transaction starts before the read
+*	data is decoded. A set clock halt bit (CH) means a stopped oscillator
+*	(new battery, first power up), the time is not valid then.
+*
+*	Write-back of dcf77 time: an accepted dcf77 time requests a write-back,
+*	the rtc is read and compared with the system time first. A rtc within
+*	+-1s is not written. Otherwise the time is written at the next second
+*	tick (writing the seconds register restarts the rtc second), but only
+*	once per RTC_WRITE_INTERVAL. The interval starts when the write is
+*	finished, a failed write is tried again after RTC_WRITE_RETRY. A manual
+*	time is written at the next second tick without compare and interval.
+*
+*	Square wave timebase: a valid read or a written time means a running
+*	rtc, the 1Hz square wave output is enabled then and the timebase of
+*	seconds is armed, when the control register is written. This covers the
+*	boot, a rtc set by the first dcf77 time and a fall back to timer 1.
+*
+*******************************************************************************
 */
 
 //! libraries
 #include "rtc.h"
+#include "system.h"
+#include "settings.h"
+#include "events.h"
+#include "protothread.h"
+#include "log.h"
+#include "timeMgnt.h"
+
+//! Own global variables
+// data of actual transaction (read or written)
+volatile uint8_t rtcBuffer[RTC_BUFFER_SIZE];
+// register pointer, number of bytes and actual byte of transaction
+volatile uint8_t rtcRegister;
+volatile uint8_t rtcLength;
+volatile uint8_t rtcIndex;
+// operation of transaction (RTC_READ or RTC_WRITE)
+volatile uint8_t rtcOperation;
+// number of tries of actual transaction
+volatile uint8_t rtcTries;
+// transaction is running
+volatile uint8_t rtcBusy;
+// read data in rtcBuffer waits for decodeRtc()
+volatile uint8_t rtcReadPending;
+// result of last transaction (data of EVENT_RTC)
+volatile uint8_t rtcResult;
+// start of transaction in system ticks (timeout)
+uint16_t rtcStartTicks;
+// counters of bus errors and retries (saturated)
+volatile uint8_t rtcBusErrors;
+volatile uint8_t rtcRetries;
+// status of last decoded time (see RTC_STATUS_*)
+uint8_t rtcStatus;
+// last valid time of rtc
+struct time rtcTime;
+// state of write-back of dcf77 time (see RTC_SYNC_*)
+uint8_t rtcSyncState;
+// seconds since last write-back (saturated)
+uint16_t rtcSyncSeconds;
+
+//! Extern global variables
+extern volatile struct time systemTime;
 
 //! initialize real time clock via i2c 
 void initRtc()
 {
 	//! port c
-	// activate PC0 and PC1 as output
-	DDRC |= (1 << PC1) | (1 << PC0);
-	// set PC0 and PC1 as high
+	// PC0 and PC1 are driven by the twi, activate pullups
+	DDRC &= ~((1 << PC1) | (1 << PC0));
 	PORTC |= (1 << PC1) | (1 << PC0);
+	
+	// bit rate 100kHz: F_CPU / (16 + 2 * TWBR * prescaler), prescaler 1
+	TWSR = 0;
+	TWBR = ((F_CPU / RTC_TWI_FREQUENCY) - 16) / 2;
+	// enable twi
+	TWCR = (1 << TWEN);
+	
+	rtcBusy = 0;
+	rtcReadPending = 0;
+	rtcBusErrors = 0;
+	rtcRetries = 0;
+	rtcStatus = 0;
+	
+	// first write-back is not limited
+	rtcSyncState = RTC_SYNC_IDLE;
+	rtcSyncSeconds = RTC_WRITE_INTERVAL;
 }
 
+//! start a transaction with the rtc, never blocks
+// input: operation (RTC_READ or RTC_WRITE), first register, data to write
+// (not used for RTC_READ) and number of bytes (max. RTC_BUFFER_SIZE)
+// return value is '1', means transaction is started (see EVENT_RTC)
+// return value is '0', means another transaction is running or read data
+// is not decoded yet
+uint8_t startRtcTransfer(uint8_t operation, uint8_t reg, const uint8_t *data, uint8_t length)
+{
+	uint8_t i = 0;
+	
+	if(rtcBusy || rtcReadPending)
+	{
+		return 0;
+	}
+	
+	if(length > RTC_BUFFER_SIZE)
+	{
+		length = RTC_BUFFER_SIZE;
+	}
+	for(i = 0; (operation == RTC_WRITE) && (i < length); i++)
+	{
+		rtcBuffer[i] = data[i];
+	}
+	rtcOperation = operation;
+	rtcRegister = reg;
+	rtcLength = length;
+	rtcTries = 1;
+	rtcBusy = 1;
+	rtcStartTicks = getSystemTicks();
+	
+	// send start condition, the rest is done by the interrupt service routine
+	TWCR = (1 << TWINT) | (1 << TWSTA) | (1 << TWEN) | (1 << TWIE);
+	return 1;
+}
 
 //! get time values from real time clock via i2c
+// starts a burst read of the time registers, see decodeRtc()
+// return value is '1', means the read is started
+// return value is '0', means the rtc is busy
 uint8_t getTimeFromRtc()
 {
-	// return value: if rtc time received sucessful value is true,
-	// if the rtc communication failed the return value is false
-	uint8_t rtcTimeSuccessfulReceived = 0;
-	
-	return rtcTimeSuccessfulReceived;
+	return startRtcTransfer(RTC_READ, RTC_REGISTER_SECONDS, 0, RTC_TIME_REGISTERS);
 }
 
-//! set time values from real time clock via i2c
+//! set time values from system time to real time clock via i2c
+// the clock halt bit is cleared (oscillator is started), 24 hour mode
+// return value is '1', means the write is started
+// return value is '0', means the rtc is busy
 uint8_t setTimeToRtc()
 {
-	// return value: if rtc time set successful value is true,
-	// if the rtc communication failed the return value is false
-	uint8_t rtcTimeSuccessfulTransmitted = 0;
+	uint8_t data[RTC_TIME_REGISTERS];
+	
+	// time is changed by interrupt service routine
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		data[0] = binaryToBcd(systemTime.second) & 0x7F;
+		data[1] = binaryToBcd(systemTime.minute);
+		data[2] = binaryToBcd(systemTime.hour);
+		data[3] = systemTime.weekday;
+		data[4] = binaryToBcd(systemTime.day);
+		data[5] = binaryToBcd(systemTime.month);
+		data[6] = binaryToBcd(systemTime.year);
+	}
+	
+	return startRtcTransfer(RTC_WRITE, RTC_REGISTER_SECONDS, data, RTC_TIME_REGISTERS);
+}
+
+//! enable square wave output of rtc with 1Hz (timebase of seconds)
+// return value is '1', means the write is started
+// return value is '0', means the rtc is busy
+uint8_t enableRtcSquareWave(void)
+{
+	// SQWE = 1 (bit 4), RS1:0 = 00b (1Hz)
+	uint8_t control = 0x10;
+	
+	return startRtcTransfer(RTC_WRITE, RTC_REGISTER_CONTROL, &control, 1);
+}
+
+//! request square wave of a running rtc as timebase of seconds
+// only with timer 1 as timebase, a busy rtc is requested with the next
+// valid time, the timebase is armed by decodeRtc()
+void requestSqwTimebase(void)
+{
+#ifdef SQW_TIMEBASE_ENABLED
+	if(getTimebase() == TIMEBASE_TIMER1)
+	{
+		enableRtcSquareWave();
+	}
+#endif
+}
+
+//! request a write-back of the system time, called for an accepted dcf77 time
+// the rtc is read first to compare it with the system time (see decodeRtc())
+void requestRtcWriteBack(void)
+{
+	// last write-back is too recent
+	if(rtcSyncSeconds < RTC_WRITE_INTERVAL)
+	{
+		return;
+	}
+	
+	// compare after read, a busy rtc is compared on next request
+	if(getTimeFromRtc())
+	{
+		rtcSyncState = RTC_SYNC_COMPARE;
+	}
+}
+
+//! request a write of the system time without compare (manual time)
+// written at the next second tick like a write-back, a busy rtc is tried
+// again with the following tick
+void requestRtcWrite(void)
+{
+	rtcSyncState = RTC_SYNC_WRITE;
+}
+
+//! second tick of rtc, called by event EVENT_TICK at the start of a second
+void rtcTick(void)
+{
+	// a hanging bus gives no interrupt: abort transaction after timeout, read
+	// data without decode (lost event) is dropped
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		if((rtcBusy || rtcReadPending) &&
+		   ((uint16_t)(getSystemTicks() - rtcStartTicks) >= PT_MS_TO_TICKS(RTC_TIMEOUT)))
+		{
+			if(rtcBusy)
+			{
+				TWCR = 0;
+				TWCR = (1 << TWEN);
+				if(rtcBusErrors < 255)
+				{
+					rtcBusErrors++;
+				}
+				rtcBusy = 0;
+				rtcResult = rtcOperation | RTC_ERROR | ((rtcRegister << 1) & RTC_REGISTER_MASK);
+				postEvent(EVENT_RTC, rtcResult);
+			}
+			rtcReadPending = 0;
+		}
+	}
+	
+	// count seconds since last write-back
+	if(rtcSyncSeconds < RTC_WRITE_INTERVAL)
+	{
+		rtcSyncSeconds++;
+	}
+	
+	// write system time at second boundary, a busy rtc at the next one
+	// (result see decodeRtc())
+	if((rtcSyncState == RTC_SYNC_WRITE) && setTimeToRtc())
+	{
+		rtcSyncState = RTC_SYNC_WRITING;
+	}
+}
+
+//! compare rtc time with system time (write-back of dcf77 time)
+// return value is '1', means rtc differs more than 1s or has another date
+// return value is '0', means rtc is within +-1s
+uint8_t compareRtcTime(void)
+{
+	int32_t difference = 0;
+	
+	// time is changed by interrupt service routine
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		if((rtcTime.day != systemTime.day) || (rtcTime.month != systemTime.month) ||
+		   (rtcTime.year != systemTime.year))
+		{
+			difference = 60;
+		}
+		else
+		{
+			difference = ((int32_t)rtcTime.hour - systemTime.hour) * 3600 +
+						 ((int16_t)rtcTime.minute - systemTime.minute) * 60 +
+						 ((int16_t)rtcTime.second - systemTime.second);
+		}
+	}
+	
+	return (difference > 1) || (difference < -1);
+}
+
+//! load system time from real time clock, only used at boot
+// waits for the burst read (about 1ms, max. RTC_TIMEOUT), the event of the
+// read is decoded again in the main loop
+// return value is '1', means the rtc is running and the system time is set
+// return value is '0', means no valid time (no rtc, clock halted)
+uint8_t loadTimeFromRtc(void)
+{
+	uint16_t startTicks = getSystemTicks();
+	
+	if(!getTimeFromRtc())
+	{
+		return 0;
+	}
+	while(rtcBusy)
+	{
+		if((uint16_t)(getSystemTicks() - startTicks) >= PT_MS_TO_TICKS(RTC_TIMEOUT))
+		{
+			return 0;
+		}
+	}
+	
+	decodeRtc(rtcResult);
+	if(!(rtcStatus & RTC_STATUS_VALID))
+	{
+		return 0;
+	}
+	
+	// set system time, the next second starts now (time management isr is running)
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		systemTime.second	= rtcTime.second;
+		systemTime.minute	= rtcTime.minute;
+		systemTime.hour		= rtcTime.hour;
+		systemTime.day		= rtcTime.day;
+		systemTime.month	= rtcTime.month;
+		systemTime.year		= rtcTime.year;
+		systemTime.weekday	= rtcTime.weekday;
+		TCNT1 = 3036;
+	}
+	return 1;
+}
+
+//! decode a finished transaction, called by event EVENT_RTC in main loop
+// input: event data (operation, first register and RTC_ERROR)
+void decodeRtc(uint8_t result)
+{
+	struct time decoded;
+	uint8_t operation = result & RTC_WRITE;
+	uint8_t reg = (result & RTC_REGISTER_MASK) >> 1;
+	
+	// end of write-back: the next one follows after RTC_WRITE_INTERVAL, a
+	// failed one is retried with an accepted dcf77 time after RTC_WRITE_RETRY
+	if((rtcSyncState == RTC_SYNC_WRITING) && (operation == RTC_WRITE) && (reg == RTC_REGISTER_SECONDS))
+	{
+		rtcSyncState = RTC_SYNC_IDLE;
+		if(result & RTC_ERROR)
+		{
+			rtcSyncSeconds = RTC_WRITE_INTERVAL - RTC_WRITE_RETRY;
+		}
+		else
+		{
+			rtcSyncSeconds = 0;
+			logEvent(LOG_EVENT_RTC_WRITE, 0);
+		}
+	}
+	
+#ifdef SQW_TIMEBASE_ENABLED
+	// written time: oscillator is running, enable its square wave
+	if(!(result & RTC_ERROR) && (operation == RTC_WRITE) && (reg == RTC_REGISTER_SECONDS))
+	{
+		requestSqwTimebase();
+	}
+	// square wave is enabled: it takes over at its next edge
+	if(!(result & RTC_ERROR) && (operation == RTC_WRITE) && (reg == RTC_REGISTER_CONTROL) &&
+	   (getTimebase() == TIMEBASE_TIMER1))
+	{
+		enableSqwTimebase();
+	}
+#endif
+	
+	if(result & RTC_ERROR)
+	{
+		rtcStatus |= RTC_STATUS_ERROR;
+		logEvent(LOG_EVENT_RTC_ERROR, ((uint16_t)rtcBusErrors << 8) | rtcRetries);
+		// no write-back to a failing rtc
+		if((rtcSyncState == RTC_SYNC_COMPARE) && (operation == RTC_READ))
+		{
+			rtcSyncState = RTC_SYNC_IDLE;
+		}
+		return;
+	}
+	
+	// only a read of the time registers is decoded, once (the read at boot
+	// is decoded by loadTimeFromRtc() before its event)
+	if((operation != RTC_READ) || (reg != RTC_REGISTER_SECONDS) || !rtcReadPending)
+	{
+		return;
+	}
+	rtcReadPending = 0;
+	rtcStatus &= ~(RTC_STATUS_ERROR | RTC_STATUS_HALTED | RTC_STATUS_VALID);
+	
+	// clock halt bit: oscillator is stopped, time is not valid
+	if(rtcBuffer[0] & 0x80)
+	{
+		rtcStatus |= RTC_STATUS_HALTED;
+		// write-back starts the oscillator
+		if(rtcSyncState == RTC_SYNC_COMPARE)
+		{
+			rtcSyncState = RTC_SYNC_WRITE;
+		}
+		return;
+	}
+	
+	decoded.second	= bcdToBinary(rtcBuffer[0] & 0x7F);
+	decoded.minute	= bcdToBinary(rtcBuffer[1] & 0x7F);
+	// 12 hour mode (bit 6) with pm flag (bit 5), else 24 hour mode
+	if(rtcBuffer[2] & 0x40)
+	{
+		decoded.hour = bcdToBinary(rtcBuffer[2] & 0x1F) % 12;
+		if(rtcBuffer[2] & 0x20)
+		{
+			decoded.hour += 12;
+		}
+	}
+	else
+	{
+		decoded.hour = bcdToBinary(rtcBuffer[2] & 0x3F);
+	}
+	decoded.weekday	= rtcBuffer[3] & 0x07;
+	decoded.day		= bcdToBinary(rtcBuffer[4] & 0x3F);
+	decoded.month	= bcdToBinary(rtcBuffer[5] & 0x1F);
+	decoded.year	= bcdToBinary(rtcBuffer[6]);
+	
+	// registers with values out of range are not valid, rtcTime keeps the
+	// last valid time
+	if((decoded.second < 60) && (decoded.minute < 60) && (decoded.hour < 24) &&
+	   (decoded.weekday >= 1) && (decoded.day >= 1) && (decoded.day <= 31) &&
+	   (decoded.month >= 1) && (decoded.month <= 12) && (decoded.year < 100))
+	{
+		rtcTime = decoded;
+		rtcStatus |= RTC_STATUS_VALID;
+		requestSqwTimebase();
+	}
+	
+	// write-back of dcf77 time: write at next second tick, if rtc differs
+	if(rtcSyncState == RTC_SYNC_COMPARE)
+	{
+		if(!(rtcStatus & RTC_STATUS_VALID) || compareRtcTime())
+		{
+			rtcSyncState = RTC_SYNC_WRITE;
+		}
+		else
+		{
+			rtcSyncState = RTC_SYNC_IDLE;
+		}
+	}
+}
+
+//! get status of last decoded time (see RTC_STATUS_*)
+uint8_t getRtcStatus(void)
+{
+	return rtcStatus;
+}
+
+//! get number of bus errors (saturated)
+uint8_t getRtcBusErrors(void)
+{
+	return rtcBusErrors;
+}
+
+//! get number of retries (saturated)
+uint8_t getRtcRetries(void)
+{
+	return rtcRetries;
+}
+
+//! convert a bcd value (two digits) to a binary value
+uint8_t bcdToBinary(uint8_t value)
+{
+	return (value >> 4) * 10 + (value & 0x0F);
+}
+
+//! convert a binary value (0 to 99) to a bcd value
+uint8_t binaryToBcd(uint8_t value)
+{
+	return ((value / 10) << 4) | (value % 10);
+}
+
+//! finish transaction: stop condition, tell main loop about result
+// input: operation and RTC_ERROR, the first register is added
+void finishRtcTransfer(uint8_t result)
+{
+	TWCR = (1 << TWINT) | (1 << TWSTO) | (1 << TWEN);
+	result |= (rtcRegister << 1) & RTC_REGISTER_MASK;
+	// read data is kept until it is decoded
+	if(result == ((RTC_REGISTER_SECONDS << 1) | RTC_READ))
+	{
+		rtcReadPending = 1;
+	}
+	rtcResult = result;
+	rtcBusy = 0;
+	postEvent(EVENT_RTC, result);
+}
+
+//! Interrupt Service Routine for when the twi has finished a bus operation
+ISR(TWI_vect)
+{
+	switch(TW_STATUS)
+	{
+		// start condition: write register pointer first
+		case TW_START:
+		{
+			TWDR = RTC_ADDRESS | TW_WRITE;
+			TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE);
+			break;
+		}
+		
+		// repeated start condition: read data
+		case TW_REP_START:
+		{
+			TWDR = RTC_ADDRESS | TW_READ;
+			TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE);
+			break;
+		}
+		
+		// slave address acknowledged: send register pointer
+		case TW_MT_SLA_ACK:
+		{
+			TWDR = rtcRegister;
+			rtcIndex = 0;
+			TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE);
+			break;
+		}
+		
+		// register pointer or data byte acknowledged
+		case TW_MT_DATA_ACK:
+		{
+			if(rtcOperation == RTC_READ)
+			{
+				// repeated start condition
+				TWCR = (1 << TWINT) | (1 << TWSTA) | (1 << TWEN) | (1 << TWIE);
+			}
+			else if(rtcIndex < rtcLength)
+			{
+				// next data byte
+				TWDR = rtcBuffer[rtcIndex++];
+				TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE);
+			}
+			else
+			{
+				finishRtcTransfer(RTC_WRITE);
+			}
+			break;
+		}
+		
+		// slave address acknowledged: receive, acknowledge all bytes but the last
+		case TW_MR_SLA_ACK:
+		{
+			rtcIndex = 0;
+			if(rtcLength > 1)
+			{
+				TWCR = (1 << TWINT) | (1 << TWEA) | (1 << TWEN) | (1 << TWIE);
+			}
+			else
+			{
+				TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE);
+			}
+			break;
+		}
+		
+		// data byte received and acknowledged
+		case TW_MR_DATA_ACK:
+		{
+			rtcBuffer[rtcIndex++] = TWDR;
+			if(rtcIndex < rtcLength - 1)
+			{
+				TWCR = (1 << TWINT) | (1 << TWEA) | (1 << TWEN) | (1 << TWIE);
+			}
+			else
+			{
+				TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE);
+			}
+			break;
+		}
+		
+		// last data byte received
+		case TW_MR_DATA_NACK:
+		{
+			rtcBuffer[rtcIndex++] = TWDR;
+			finishRtcTransfer(RTC_READ);
+			break;
+		}
 		
-	return rtcTimeSuccessfulTransmitted;
+		// nack of slave, lost arbitration or bus error
+		default:
+		{
+			if(TW_STATUS == TW_BUS_ERROR)
+			{
+				if(rtcBusErrors < 255)
+				{
+					rtcBusErrors++;
+				}
+			}
+			
+			if(rtcTries < RTC_RETRIES + 1)
+			{
+				// stop and start again
+				rtcTries++;
+				if(rtcRetries < 255)
+				{
+					rtcRetries++;
+				}
+				TWCR = (1 << TWINT) | (1 << TWSTO) | (1 << TWSTA) | (1 << TWEN) | (1 << TWIE);
+			}
+			else
+			{
+				finishRtcTransfer(rtcOperation | RTC_ERROR);
+			}
+			break;
+		}
+	}
 }
\ No newline at end of file
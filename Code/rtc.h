@@ -13,9 +13,51 @@
 
 //! libraries
 #include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/twi.h>
+#include <util/atomic.h>
 #include <stdint.h>
 
 //! function declarations
 void initRtc(void);
+uint8_t startRtcTransfer(uint8_t operation, uint8_t reg, const uint8_t *data, uint8_t length);
 uint8_t getTimeFromRtc(void);
-uint8_t setTimeToRtc(void);
\ No newline at end of file
+uint8_t setTimeToRtc(void);
+uint8_t loadTimeFromRtc(void);
+uint8_t enableRtcSquareWave(void);
+void requestSqwTimebase(void);
+void requestRtcWriteBack(void);
+void requestRtcWrite(void);
+void rtcTick(void);
+uint8_t compareRtcTime(void);
+void decodeRtc(uint8_t result);
+uint8_t getRtcStatus(void);
+uint8_t getRtcBusErrors(void);
+uint8_t getRtcRetries(void);
+uint8_t bcdToBinary(uint8_t value);
+uint8_t binaryToBcd(uint8_t value);
+void finishRtcTransfer(uint8_t result);
+
+//! DS1307
+#define RTC_ADDRESS				0xD0	// slave address (shifted, 1101000b)
+#define RTC_REGISTER_SECONDS	0x00	// first time register (bit 7: clock halt)
+#define RTC_REGISTER_CONTROL	0x07	// control register (square wave output)
+#define RTC_TIME_REGISTERS		7		// seconds to year
+#define RTC_BUFFER_SIZE			8		// max. bytes of a transaction
+
+//! Operation of transaction (data of EVENT_RTC)
+#define RTC_READ				0x00	// registers read
+#define RTC_WRITE				0x01	// registers written
+#define RTC_REGISTER_MASK		0x0E	// first register of transaction (bit 3 to 1)
+#define RTC_ERROR				0x80	// transaction failed after all retries
+
+//! Status of last decoded time (see getRtcStatus())
+#define RTC_STATUS_VALID		0x01	// time registers are valid (see rtcTime)
+#define RTC_STATUS_HALTED		0x02	// oscillator is stopped (clock halt bit)
+#define RTC_STATUS_ERROR		0x04	// last transaction failed
+
+//! State of write-back of dcf77 time
+#define RTC_SYNC_IDLE			0		// no write-back
+#define RTC_SYNC_COMPARE		1		// rtc is read for comparison
+#define RTC_SYNC_WRITE			2		// rtc is written at next second tick
+#define RTC_SYNC_WRITING		3		// write is running, waits for result
\ No newline at end of file
@@ -19,14 +19,16 @@
 #endif
 
 // PWM settings (value range is 8 bit)
+// gain and offset of perceived lightness, limitation of pwm value
 #define PWMVALUE_GAIN 1
 #define PWMVALUE_OFFSET 0
 #define PWMVALUE_MINIMUM 1
 #define PWMVALUE_MAXIMUM 254
 
-// Intensity VDR settings (value range is 8 bit)
-#define INTENSITY_GAIN 3
-#define INTENSITY_OFFSET 0
+// Intensity VDR settings (logarithmic light level, value range is 8 bit)
+// range of VDR in 1/32 octaves, log2(500R / R_VDR) * 32
+#define INTENSITY_LOG_DARK -352		// -11 octaves, VDR about 1MR
+#define INTENSITY_LOG_BRIGHT 96		// +3 octaves, VDR about 60R
 #define INTENSITY_MINIMUM 0
 #define INTENSITY_MAXIMUM 254
 
@@ -36,6 +38,56 @@
 #define POTIVALUE_MINIMUM 0
 #define POTIVALUE_MAXIMUM 254
 
+// adc oversampling: 2^ADC_OVERSAMPLING samples per channel (range 4 to 6,
+// 16 to 64 samples), published values have 12 bit
+#define ADC_OVERSAMPLING 4
+#define ADC_SAMPLES (1 << ADC_OVERSAMPLING)
+// time between two sampling rounds in ms
+#define ADC_PUBLISH_TIME 100
+
+// brightness pipeline: ema filter of light level (alpha = 1 / 2^shift),
+// hysteresis of light level, slew rate of perceived lightness (step per time in ms)
+#define BRIGHTNESS_FILTER_SHIFT 3
+#define BRIGHTNESS_HYSTERESIS 2
+#define BRIGHTNESS_SLEW_TIME 32
+#define BRIGHTNESS_SLEW_STEP 2
+
+// automatic calibration of light level: decay of learned range per hour
+// (1/168 -> about 7 days), minimum range in 1/32 octaves (4 octaves)
+#define CALIBRATION_DECAY_HOURS 168
+#define CALIBRATION_MIN_RANGE 128
+
+// supply voltage: bandgap voltage in mV (typical 1100mV, calibrate per unit),
+// derating of maximum pwm value from start to end voltage in mV, lifted
+// again above the recover voltage in mV, hysteresis of led limit in mV
+#define SUPPLY_BANDGAP 1100
+#define SUPPLY_DERATE_START 4600
+#define SUPPLY_DERATE_END 4200
+#define SUPPLY_DERATE_RECOVER 4700
+#define SUPPLY_DERATE_PWMVALUE 32
+#define SUPPLY_HYSTERESIS 100
+
+// current limiter of matrix: current of one led in mA (100% pwm), limit of
+// average current of matrix in mA, compensation of dense rows in 1/256 per led
+#define MATRIX_LED_CURRENT 20
+#define MATRIX_CURRENT_LIMIT 250
+#define MATRIX_DENSE_COMPENSATION 4
+
+// night schedule (default): start and end time, weekdays of start time
+// (bit 0 monday to bit 6 sunday), mode (see nightMgnt.h), pwm value of deep
+// dim mode and time in seconds the display is woken by a switch
+#define NIGHT_START_HOUR 23
+#define NIGHT_START_MINUTE 0
+#define NIGHT_END_HOUR 6
+#define NIGHT_END_MINUTE 0
+#define NIGHT_WEEKDAYS 0x7F
+#define NIGHT_MODE NIGHT_MODE_DIM
+#define NIGHT_DIM_PWMVALUE 1
+// frames without output after every frame in deep dim mode (less load of
+// timer 2 isr, 1: about 40Hz per frame, max. 21)
+#define NIGHT_DIM_FRAME_SKIP 1
+#define NIGHT_WAKE_TIME 30
+
 // delay time of load signal (pulse width) in s
 #define DELAYLOAD 1
 
@@ -49,9 +101,103 @@
 #define MATRIXHIGH 0b11111111
 #define MATRIXLOW 0b11110000
 
+// step time of searching sequence in ms
+#define SEARCHING_STEP_TIME 1000
+
+// blink time in menu mode in ms
+#define MENU_BLINK_TIME 1000
+
+// menu values: step of manual display brightness, shift of pie in minutes
+// (default and maximum)
+#define MENU_BRIGHTNESS_STEP 4
+#define PIE_SHIFT_MINUTES 2
+#define PIE_SHIFT_MAXIMUM 4
+
+// button driver: sample time in timer 3 ticks (1250 * 4us = 5ms, all repeat
+// rates are whole samples), samples which have to be equal for a new state
+// (6 samples = 30ms)
+#define BUTTON_SAMPLE_TIME 1250
+#define BUTTON_DEBOUNCE_MASK 0x3F
+// long press time in samples (120 * 5ms = 600ms), time between repeats of
+// up and down in samples (100: 2/s, 25: 8/s, 10: 20/s) and number of repeats
+// at slow and medium speed (2s each)
+#define BUTTON_LONG_TIME 120
+#define BUTTON_REPEAT_SLOW 100
+#define BUTTON_REPEAT_MEDIUM 25
+#define BUTTON_REPEAT_FAST 10
+#define BUTTON_REPEAT_SLOW_COUNT 4
+#define BUTTON_REPEAT_MEDIUM_COUNT 16
+
+// rtc (DS1307): twi bit rate in Hz, retries of a failed transaction,
+// timeout of a hanging transaction in ms
+#define RTC_TWI_FREQUENCY 100000UL
+#define RTC_RETRIES 3
+#define RTC_TIMEOUT 100
+// minimum time between two write-backs of dcf77 time in seconds (1 hour)
+// and after a failed write-back (1 minute)
+#define RTC_WRITE_INTERVAL 3600
+#define RTC_WRITE_RETRY 60
+// 1Hz square wave of rtc (PA6) as timebase of seconds, whenever the rtc is
+// running (falls back to timer 1 when pulses are missing, armed again with
+// the next valid rtc time)
+#define SQW_TIMEBASE_ENABLED
+
+// configuration in eeprom: number of slots (wear levelling, 7 bytes per slot)
+#define CONFIG_SLOTS 8
+
+// event log in eeprom: entries of ring buffer (8 bytes per entry), entries
+// waiting in ram, number of entries written as batch and maximum time of an
+// entry in ram in ms (10 minutes)
+#define LOG_ENTRIES 128
+#define LOG_BUFFER_SIZE 8
+#define LOG_BATCH 4
+#define LOG_FLUSH_TIME 600000UL
+
 // task pre counter value
 #define TASK_PRECOUNTER 15
 
+// size of event queue from isr to main loop (has to be a power of two, max 128)
+#define EVENT_QUEUE_SIZE 16
+
+// usart 0 for serial output with 38400 baud (8N1)
+// UBRR = 16MHz / (16 * 38400) - 1 = 25 (error 0,2%)
+// IMPORTANT: TXD0 (PD1) is connected with the reset signal (RSTREG) of the
+// led matrix shift registers. Before usart 0 is enabled, RSTREG has to be
+// tied to +5V, the reset pulse of the led matrix is skipped then.
+//#define USART0_ENABLED
+#define USART0_UBRR 25
+// ring buffers of usart 0 (have to be a power of two, max 128), a full
+// transmit buffer drops the output instead of waiting
+#define USART0_TX_BUFFER_SIZE 128
+#define USART0_RX_BUFFER_SIZE 32
+// command console on usart 0: maximum length of a command line and free
+// space of the transmit buffer, before the console sends the next line
+// (longest line with prompt: help with all commands 54 + 2 bytes)
+#define CONSOLE_LINE_SIZE 32
+#define CONSOLE_OUTPUT_SPACE 64
+// serial bootloader (see Bootloader/bootloader.c), started with console
+// command 'boot': word address of boot section (BOOTSZ = 4096W_F000)
+#define BOOTLOADER_START 0xF000
+// binary telemetry stream of dcf77 reception, adc and brightness on usart 0
+// (needs USART0_ENABLED), started with console command 'tele on'
+// queue of samples from isr to main loop (has to be a power of two, max 128)
+//#define TELEMETRY_ENABLED
+#define TELEMETRY_QUEUE_SIZE 16
+
+// deadline supervision of periodic tasks (in seconds after last run)
+// the watchdog is fed only, if all supervised tasks are in time
+#define DEADLINE_HALF_SECOND 3
+#define DEADLINE_SECOND 3
+#define DEADLINE_MINUTE 63
+// watchdog timeout (see avr/wdt.h), the interrupt saves the stack pointer
+// after the first timeout, the reset follows after the second one
+#define WATCHDOG_TIMEOUT WDTO_1S
+
+// task profiling (execution time and latency of tasks) in debug configuration
+#ifdef DEBUG
+#define TASK_PROFILING
+#endif
+
 //! Words - horizontal (in rows)
 #define WORD_ROW00_S_H			0b11000000
 #define WORD_ROW00_S_L			0b00000000
@@ -14,10 +14,136 @@
 //! Own header
 #include "system.h"
 #include "settings.h"
+#include "timeMgnt.h"
+#include "usart.h"
+#include "ledMatrix.h"
+
+//! Libraries
+#include <avr/wdt.h>
+#include <avr/pgmspace.h>
+#include <util/atomic.h>
 
 //! Own global variables
 volatile struct systemParameter systemConfig;
 volatile struct time systemTime;
+// reset flags of mcu status register, written before the c runtime clears .bss
+uint8_t resetFlags __attribute__ ((section (".noinit")));
+// time from power up to the first frame with a valid time in ms (boot metric)
+uint32_t firstFrameTime = FIRST_FRAME_NONE;
+
+// fraction of logarithm of base 2 in 1/32 steps: round(32 * log2(1 + i/64))
+const uint8_t log2Mantissa[64] PROGMEM =
+{
+	 0,  1,  1,  2,  3,  3,  4,  5,  5,  6,  7,  7,  8,  9,  9, 10,
+	10, 11, 11, 12, 13, 13, 14, 14, 15, 15, 16, 16, 17, 17, 18, 18,
+	19, 19, 20, 20, 21, 21, 22, 22, 22, 23, 23, 24, 24, 25, 25, 25,
+	26, 26, 27, 27, 27, 28, 28, 29, 29, 29, 30, 30, 31, 31, 31, 32
+};
+
+//! Functional prototypes
+void captureResetFlags(void) __attribute__ ((naked, used, section (".init3")));
+
+//! Save and clear reset flags, runs before main() in section .init3
+// the watchdog stays enabled after a watchdog reset, so it has to be switched
+// off as early as possible (before the long initialization of the c runtime)
+void captureResetFlags(void)
+{
+	resetFlags = MCUSR;
+	MCUSR = 0;
+	wdt_disable();
+}
+
+//! Get reset flags of last reset (see MCUSR: PORF, EXTRF, BORF, WDRF, JTRF)
+uint8_t getResetFlags(void)
+{
+	return resetFlags;
+}
+
+//! Save time from power up to the first frame with a valid time
+// called for every frame with time, only the first one is saved
+// timer 3 runs since initButtons() and overflows after 262ms: a fast boot is
+// measured with its 4us ticks, a later frame with the system ticks (16,384ms)
+void markFirstValidFrame(void)
+{
+	uint16_t ticks = 0;
+	
+	if(firstFrameTime != FIRST_FRAME_NONE)
+	{
+		return;
+	}
+	
+	ticks = getSystemTicks();
+	if(ticks < FIRST_FRAME_FAST_TICKS)
+	{
+		// 16 bit register is read by the task profiler as well
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			firstFrameTime = TCNT3 / 250;
+		}
+	}
+	else
+	{
+		firstFrameTime = ((uint32_t)ticks * 16384) / 1000;
+	}
+	
+#ifdef USART0_ENABLED
+	// report first valid frame: 'F' and time in ms
+	usart0Transmit('F');
+	usart0TransmitHex(firstFrameTime >> 24);
+	usart0TransmitHex(firstFrameTime >> 16);
+	usart0TransmitHex(firstFrameTime >> 8);
+	usart0TransmitHex(firstFrameTime);
+	usart0Transmit('\r');
+	usart0Transmit('\n');
+#endif
+}
+
+//! Get time from power up to the first frame with a valid time in ms
+// FIRST_FRAME_NONE means no valid time was shown yet
+uint32_t getFirstFrameTime(void)
+{
+	return firstFrameTime;
+}
+
+//! Start serial bootloader in boot section (see Bootloader/bootloader.c)
+// the function doesn't return, the bootloader starts the application again
+// (MCUSR is cleared, so the bootloader waits BOOT_REQUEST_TIME for a host)
+// with a jump to the reset vector: the peripherals with interrupts are set
+// back to their reset values, no isr fires before its initialization
+void startBootloader(void)
+{
+	void (*bootloader)(void) = (void (*)(void))BOOTLOADER_START;
+	
+	// no interrupts and no supervision, led matrix off (multiplexing stops)
+	cli();
+	wdt_disable();
+	stopMatrix();
+	
+	// timers: no clock source, no interrupts, flags cleared
+	TCCR0B = 0;
+	TCCR1B = 0;
+	TCCR3B = 0;
+	TIMSK0 = 0;
+	TIMSK1 = 0;
+	TIMSK2 = 0;
+	TIMSK3 = 0;
+	TIFR0 = 0xFF;
+	TIFR1 = 0xFF;
+	TIFR2 = 0xFF;
+	TIFR3 = 0xFF;
+	// pin change interrupts (dcf77 signal, square wave of rtc)
+	PCICR = 0;
+	PCMSK0 = 0;
+	PCMSK2 = 0;
+	PCIFR = 0xFF;
+	// adc, twi and usarts (a running transmission is completed)
+	ADCSRA = 0;
+	TWCR = 0;
+	UCSR0B = 0;
+	UCSR1B = 0;
+	
+	bootloader();
+}
 
 //! Write Initial values
 void initSystem(void)
@@ -27,20 +153,25 @@ void initSystem(void)
 	// - xxxx.xx0xb searching dcf77 signal inactive
 	// - xxxx.x0xxb rtc time is not available
 	// - xxxx.0xxxb setting menu is inactive
-	// - xxx1.xxxxb automatic time mode is active
-	systemConfig.status = 0x10;
+	// - xxx0.xxxxb automatic time mode is active (see menu.c, saved in eeprom)
+	systemConfig.status = 0x00;
 	// default light intensity
 	systemConfig.lightIntensity = 10;
 	// set value of potentiometer 		
 	systemConfig.potentiometerValue = 10;
+	// no manual display brightness
+	systemConfig.manualBrightness = 0;
+	// default shift of pie
+	systemConfig.pieShift = PIE_SHIFT_MINUTES;
 	// default display brightness
 	systemConfig.displayBrightness = calcuateBrightness(systemConfig.lightIntensity, systemConfig.potentiometerValue);
 	// set default system display settings
 	// - xxxx.xxx0b straight pie
 	// - xxxx.001xb original with birthday and horses@6pm
+	// - xxx1.xxxxb automatic calibration of light level is active
 	// - x1xx.xxxxb automatic display brightness regulation is active
 	// - 1xxx.xxxxb no sequence when searching signal
-	systemConfig.displaySetting = 0xC2; // see above
+	systemConfig.displaySetting = 0xD2; // see above
 	// set display status to dark
 	systemConfig.displayStatus = DISPLAY_STATE_DARK;
 	// system version 0.0.3
@@ -57,6 +188,8 @@ void initSystem(void)
 	systemTime.weekday	= 1; // monday
 }
 
+//! Calculate perceived lightness of display (range 0 dark to 255 bright)
+// the pwm value is calculated by the brightness pipeline (see brightness.c)
 uint8_t calcuateBrightness(uint8_t lightIntensity, uint8_t potentiometerValue)
 {
 	int16_t brightness = 0;
@@ -71,7 +204,8 @@ uint8_t calcuateBrightness(uint8_t lightIntensity, uint8_t potentiometerValue)
 	}
 	else
 	{
-		brightness = potentiometerValue;
+		// manual display brightness (set in menu)
+		brightness = potentiometerValue + systemConfig.manualBrightness;
 	}
 	
 	// gain and offset calculation (no overflow protection)
@@ -79,42 +213,85 @@ uint8_t calcuateBrightness(uint8_t lightIntensity, uint8_t potentiometerValue)
 	brightness += PWMVALUE_OFFSET;
 	
 	
-	if (brightness >= PWMVALUE_MAXIMUM)
+	// limitation
+	if (brightness >= 255)
 	{
-		brightness = PWMVALUE_MAXIMUM;
+		brightness = 255;
 	}
 	
-	if (brightness <= PWMVALUE_MINIMUM)
+	if (brightness <= 0)
 	{
-		brightness = PWMVALUE_MINIMUM;
+		brightness = 0;
 	}
 	return (uint8_t)brightness;
 }
 
-uint8_t calculateIntensity(uint8_t intensity)
+//! Calculate logarithmic light value of the VDR
+// input: filtered 12 bit adc value of VDR divider (500R pullup to AVCC, VDR to GND)
+// output: log2(500R / R_VDR) in 1/32 octaves, the light is proportional to 1 / R_VDR
+// R_VDR / 500R = adc / (4096 - adc)
+int16_t calculateLightLog(uint16_t adcValue)
 {
-	// because of overflow handling
-	uint16_t intensity16;
+	// limitation, no logarithm of zero
+	if (adcValue < 1)
+	{
+		adcValue = 1;
+	}
+	if (adcValue > 4095)
+	{
+		adcValue = 4095;
+	}
+	
+	return log2Fixed(4096 - adcValue) - log2Fixed(adcValue);
+}
 
-	// inverting value
-	intensity = ~intensity;
-	intensity16 = intensity;
+//! Calculate light level from logarithmic light value
+// input: light value, dark and bright end of range (all in 1/32 octaves)
+// output: light level (range is 0 dark to 255 bright)
+uint8_t calculateLightLevel(int16_t lightLog, int16_t dark, int16_t bright)
+{
+	int32_t level = lightLog;
 	
-	// gain and offset calculation (no overflow protection)
-	intensity16 *= INTENSITY_GAIN;
-	intensity16 += INTENSITY_OFFSET;
+	// no range, no division by zero
+	if (bright <= dark)
+	{
+		bright = dark + 1;
+	}
+	
+	// map range from dark to bright on 8 bit
+	level -= dark;
+	level *= 255;
+	level /= (bright - dark);
 	
 	// limitation
-	if (intensity16 >= INTENSITY_MAXIMUM)
+	if (level >= INTENSITY_MAXIMUM)
 	{
-		intensity16 = INTENSITY_MAXIMUM;
+		level = INTENSITY_MAXIMUM;
 	}
 	
-	if (intensity16 <= INTENSITY_MINIMUM)
+	if (level <= INTENSITY_MINIMUM)
 	{
-		intensity16 = INTENSITY_MINIMUM;
+		level = INTENSITY_MINIMUM;
 	}
-	return (uint8_t)intensity16;	
+	return (uint8_t)level;
+}
+
+//! Calculate logarithm of base 2 in 1/32 steps
+// input: 12 bit value (range 1 to 4095)
+// output: log2(value) * 32 (range 0 to 384)
+int16_t log2Fixed(uint16_t value)
+{
+	uint8_t exponent = 11;
+	
+	// normalize value: highest bit is moved to bit 11
+	while (!(value & 0x0800) && exponent)
+	{
+		value <<= 1;
+		exponent--;
+	}
+	
+	// 6 bits below highest bit are the mantissa
+	return (exponent * 32) + pgm_read_byte(&log2Mantissa[(value >> 5) & 0x3F]);
 }
 
 uint8_t calculatePotiValue(uint8_t potiValue)
@@ -70,9 +70,11 @@
 *	210d		- brightness
 *	211d			- automatic
 *	212d			- manual
+*	213d				- manual brightness value
 *	220d		- pie
 *	221d			- straight
 *	222d			- shift
+*	223d				- shift in minutes
 *	230d		- character variant
 *	231d			- standard
 *	232d			- brihtday and horse mode
@@ -83,22 +85,26 @@
 *	251d		- debug Mode 1
 *	252d		- debug Mode 2
 *	253d		- debug Mode 3
+*	254d		- debug Mode 4 (reset, watchdog and supply voltage)
 *
 *******************************************************************************
 * Display Settings: variable "displaySetting" unint8
-*	vqxxyyyzb structure of variable
+*	vqxcyyyzb structure of variable
 *
 *		  zb (bit 0): shows pie variant
 *		  0b original straight pie
-*		  1b shifted pie (for 2 minutes)
+*		  1b shifted pie (for 'pieShift' minutes)
 *
 *		yyyb (bit 3 to bit 1): shows character variant 
 *		000b standard without birthday and horse information
 *		001b birthday (01.01., 16.01., 07.08., 22.09., 08.12.) and horses@6pm
 *		...b open for other variants
 * 	
-*	  xxb (bit 5 to bit 4):	open for other variants
-*	  ..b open for other variants
+*	   cb (bit 4): shows automatic calibration of light level
+*	   0b fixed range of light level (INTENSITY_LOG_DARK to INTENSITY_LOG_BRIGHT)
+*	   1b range of light level is learned from the measured values
+*
+*	  xb (bit 5):	open for other variants
 *
 *	 qb (bit 6): shows automatic display brightness variant
 *	 0b automatic display brightness regulation is inactive 
@@ -138,13 +144,21 @@ struct systemParameter
 	uint8_t displayBrightness;		// display brightness (range 0 dark to 255 bright)
 	uint8_t displayStatus;			// actual display status
 	uint8_t version;				// software system version
+	uint8_t manualBrightness;		// manual display brightness, added to potentiometer value (range 0 to 255)
+	uint8_t pieShift;				// shift of pie in minutes (1 to PIE_SHIFT_MAXIMUM)
 };
 
 //! Functional prototypes
 void initSystem(void);
 uint8_t calcuateBrightness(uint8_t lighIntensity, uint8_t potentiometerValue);
-uint8_t calculateIntensity(uint8_t intensity);
+int16_t calculateLightLog(uint16_t adcValue);
+uint8_t calculateLightLevel(int16_t lightLog, int16_t dark, int16_t bright);
+int16_t log2Fixed(uint16_t value);
 uint8_t calculatePotiValue(uint8_t potiValue);
+uint8_t getResetFlags(void);
+void markFirstValidFrame(void);
+uint32_t getFirstFrameTime(void);
+void startBootloader(void);
 
 //! Display State - horizontal (in rows)
 // Default:
@@ -182,9 +196,11 @@ uint8_t calculatePotiValue(uint8_t potiValue);
 #define DISPLAY_STATE_MENU_BRIGTHNESS		210	// 		- brightness
 #define DISPLAY_STATE_MENU_BRIGHT_AUTO		211	// 			- automatic
 #define DISPLAY_STATE_MENU_BRIGHT_MANU		212	// 			- manual
+#define DISPLAY_STATE_MENU_BRIGHT_VALUE		213	// 				- manual brightness value
 #define DISPLAY_STATE_MENU_PIE				220	// 		- pie
 #define DISPLAY_STATE_MENU_PIE_STRAIGHT		221	// 			- straight
 #define DISPLAY_STATE_MENU_PIE_SHIFT		222	// 			- shift
+#define DISPLAY_STATE_MENU_PIE_MINUTES		223	// 				- shift in minutes
 #define DISPLAY_STATE_MENU_CHAR				230	// 		- character variant
 #define DISPLAY_STATE_MENU_CHAR_STANDARD	231	// 			- standard
 #define DISPLAY_STATE_MENU_CHAR_BIRTHDAY	232	// 			- brithday and horse mode
@@ -194,4 +210,9 @@ uint8_t calculatePotiValue(uint8_t potiValue);
 #define DISPLAY_STATE_MENU_DBG				250 // - debug Mode
 #define DISPLAY_STATE_MENU_DBG1				251 //		- debug Mode 1
 #define DISPLAY_STATE_MENU_DBG2				252 //		- debug Mode 2
-#define DISPLAY_STATE_MENU_DBG3				253 //		- debug Mode 3
\ No newline at end of file
+#define DISPLAY_STATE_MENU_DBG3				253 //		- debug Mode 3
+#define DISPLAY_STATE_MENU_DBG4				254 //		- debug Mode 4
+
+//! First frame with valid time (see markFirstValidFrame())
+#define FIRST_FRAME_NONE					0xFFFFFFFF	// no valid time shown yet
+#define FIRST_FRAME_FAST_TICKS				15			// system ticks measured with timer 3 (245ms)
\ No newline at end of file
@@ -22,30 +22,157 @@
 *	x-------b (bit 7): shows request flag of hour task
 *
 *******************************************************************************
+* Supervisor:
+*	The watchdog is fed in main loop only, if every supervised task has run
+*	within its deadline. A hanging task or a missed deadline resets the mcu
+*	after the watchdog timeout. The running task (or the task with the missed
+*	deadline) is kept in section .noinit and can be read after the reset.
+*	The watchdog runs in interrupt and reset mode: the first timeout calls
+*	the watchdog interrupt, which saves the stack pointer of the hanging
+*	code, the second timeout resets the mcu. With disabled interrupts the
+*	mcu is reset without a saved stack pointer (0).
+*
+*******************************************************************************
 */
 
 //! Libraries
 #include "taskMgnt.h"
 #include "tasks.h"
 #include "settings.h"
+#include "events.h"
+#include "menu.h"
+#include "dcf77.h"
+#include "profiler.h"
+#include "system.h"
+#include "ledMatrix.h"
+#include "adc.h"
+#include "brightness.h"
+#include "nightMgnt.h"
+#include "rtc.h"
+#include "config.h"
+#include "log.h"
+#include "console.h"
+#include "telemetry.h"
 
 //! Own global variables
 volatile uint8_t taskFlags;
+// supervisor record, not cleared by a reset
+struct supervisorRecord supervisor __attribute__ ((section (".noinit")));
+// seconds counter of supervisor, incremented by timer 1
+volatile uint8_t supervisorSeconds;
+// second of last run of each task
+uint8_t taskLastRun[8];
+// deadline of each task in seconds (0: task is not supervised)
+const uint8_t taskDeadline[8] = {DEADLINE_HALF_SECOND, DEADLINE_SECOND, DEADLINE_MINUTE, 0, 0, 0, 0, 0};
+
+//! Functional prototypes
+static void supervisorBegin(uint8_t task);
+static void supervisorEnd(uint8_t task);
 
 //! Initialize Task System
 void initTasks(void)
 {
 	// set no request
 	taskFlags = 0;
+	// empty event queue
+	initEvents();
+	// start deadline supervision
+	initSupervisor();
+}
+
+//! check if an event was posted by an interrupt service routine
+void checkForEvent(void)
+{
+	struct event actualEvent;
+
+	// handle all queued events
+	while (getEvent(&actualEvent))
+	{
+		supervisorBegin(SUPERVISOR_EVENTS);
+		switch(actualEvent.type)
+		{
+			// second tick of time management
+			case EVENT_TICK:
+				// calculate actual task
+				calculateTaskTiming();
+				// write-back of dcf77 time to rtc
+				rtcTick();
+				break;
+			// switch is pressed
+			case EVENT_BUTTON:
+				// a switch in night mode only wakes the display
+				if(wakeNightMgnt())
+				{
+					break;
+				}
+				PROFILE_BEGIN(PROFILE_MENU);
+				menuSwitchEvent(actualEvent.data);
+				PROFILE_END(PROFILE_MENU);
+				break;
+			// switch is hold for a long time (ok enters menu)
+			case EVENT_BUTTON_LONG:
+				menuLongPressEvent(actualEvent.data);
+				break;
+			// switch is released (not used by menu)
+			case EVENT_BUTTON_RELEASE:
+				break;
+			// dcf77 frame received completely
+			case EVENT_DCF_FRAME:
+				decodeDcf77();
+				break;
+			// filtered adc value published
+			case EVENT_ADC_SAMPLE:
+				actualizeBrightness(actualEvent.data);
+				break;
+			// rtc transaction finished
+			case EVENT_RTC:
+				decodeRtc(actualEvent.data);
+				break;
+			default:
+				break;
+		}
+		supervisorEnd(SUPERVISOR_EVENTS);
+	}
+}
+
+//! run all threads (protothreads), called in every pass of main loop
+// a waiting thread returns immediately, see protothread.h
+void checkForThreads(void)
+{
+	supervisorBegin(SUPERVISOR_THREADS);
+	
+	// searching sequence of display
+	threadSearchingSequence();
+	// blinking sequence of menu
+	threadMenuBlink();
+	// sampling rounds of adc
+	threadAdc();
+	// slew limiter of display brightness
+	threadBrightness();
+	// write of configuration to eeprom
+	threadConfig();
+	// write of event log to eeprom
+	threadLog();
+#ifdef USART0_ENABLED
+	// command console on usart 0
+	threadConsole();
+#endif
+#ifdef TELEMETRY_ENABLED
+	// frames of telemetry samples
+	threadTelemetry();
+#endif
+	
+	supervisorEnd(SUPERVISOR_THREADS);
 }
 
-//! calculate task timing and set flags
+//! calculate task timing and set flags, called by second tick event
 void calculateTaskTiming(void)
 {
 	static uint8_t taskCounterHours		= 0;	// counts hours
 	static uint8_t taskCounterMinutes	= 0;	// counts minutes
 	static uint8_t taskCounterSeconds	= 0;	// counts seconds
 	static uint8_t taskPreCounter		= 0;	// counts pre seconds	
+	uint8_t newTaskFlags				= 0;	// flags of new requests
 	
 	taskPreCounter++;
 	/*if (taskPreCounter == TASK_PRECOUNTER/2-1)
@@ -58,7 +185,7 @@ void calculateTaskTiming(void)
 		taskCounterSeconds++;
 		
 		// set request flag for second task and half second task
-		taskFlags |= 0b00000011;
+		newTaskFlags |= 0b00000011;
 		
 		if (taskCounterSeconds >= 60)
 		{
@@ -66,14 +193,14 @@ void calculateTaskTiming(void)
 			taskCounterMinutes++;
 			
 			// set request flag for minute task
-			taskFlags |= 0b00000100;
+			newTaskFlags |= 0b00000100;
 			
 			if (taskCounterMinutes >= 60)
 			{
 				taskCounterMinutes = 0;
 				taskCounterHours++;
 				// set request flag for hour task
-				taskFlags |= 0b10000000;
+				newTaskFlags |= 0b10000000;
 				
 				if (taskCounterHours >= 24)
 				{
@@ -87,25 +214,29 @@ void calculateTaskTiming(void)
 			{
 				case 5:
 					// set request flag for 5-minute task
-					taskFlags |= 0b00001000;
+					newTaskFlags |= 0b00001000;
 					break;
 				case 10:
 					// set request flag for 10-minute task
-					taskFlags |= 0b00010000;
+					newTaskFlags |= 0b00010000;
 					break;
 				case 15:
 					// set request flag for 15-minute task
-					taskFlags |= 0b00100000;
+					newTaskFlags |= 0b00100000;
 					break;
 				case 30:
 					// set request flag for 30-minute task
-					taskFlags |= 0b01000000;
+					newTaskFlags |= 0b01000000;
 					break;
 				default:
 					break;
 			}
 		}
 	}	
+
+	// record requests for profiling and set task flags
+	PROFILE_REQUEST(newTaskFlags);
+	taskFlags |= newTaskFlags;
 }
 
 //! check if a task flag / request is set
@@ -117,7 +248,11 @@ void checkForTask(void)
 	if (taskFlags & 0b00000001)
 	{
 		// run task
+		supervisorBegin(0);
+		PROFILE_BEGIN(PROFILE_TASK_HALF_SECOND);
 		taskHalfSecond();
+		PROFILE_END(PROFILE_TASK_HALF_SECOND);
+		supervisorEnd(0);
 		// reset task flag
 		taskFlags &= ~0b00000001;
 	}
@@ -126,7 +261,11 @@ void checkForTask(void)
 	if (taskFlags & 0b00000010)
 	{
 		// run task
+		supervisorBegin(1);
+		PROFILE_BEGIN(PROFILE_TASK_SECOND);
 		taskSecond();
+		PROFILE_END(PROFILE_TASK_SECOND);
+		supervisorEnd(1);
 		// reset task flag
 		taskFlags &= ~0b00000010;
 	}
@@ -135,7 +274,11 @@ void checkForTask(void)
 	if (taskFlags & 0b00000100)
 	{
 		// run task
+		supervisorBegin(2);
+		PROFILE_BEGIN(PROFILE_TASK_MINUTE);
 		taskMinute();
+		PROFILE_END(PROFILE_TASK_MINUTE);
+		supervisorEnd(2);
 		// reset task flag
 		taskFlags &= ~0b00000100;
 	}
@@ -144,7 +287,11 @@ void checkForTask(void)
 	if (taskFlags & 0b00001000)
 	{
 		// run task
+		supervisorBegin(3);
+		PROFILE_BEGIN(PROFILE_TASK_FIVE_MINUTE);
 		taskFiveMinute();
+		PROFILE_END(PROFILE_TASK_FIVE_MINUTE);
+		supervisorEnd(3);
 		// reset task flag
 		taskFlags &= ~0b00001000;
 	}
@@ -153,7 +300,11 @@ void checkForTask(void)
 	if (taskFlags & 0b00010000)
 	{
 		// run task
+		supervisorBegin(4);
+		PROFILE_BEGIN(PROFILE_TASK_TEN_MINUTE);
 		taskTenMinute();
+		PROFILE_END(PROFILE_TASK_TEN_MINUTE);
+		supervisorEnd(4);
 		// reset task flag
 		taskFlags &= ~0b00010000;
 	}
@@ -162,7 +313,11 @@ void checkForTask(void)
 	if (taskFlags & 0b00100000)
 	{
 		// run task
+		supervisorBegin(5);
+		PROFILE_BEGIN(PROFILE_TASK_FIFTEEN_MINUTE);
 		taskFifteenMinute();
+		PROFILE_END(PROFILE_TASK_FIFTEEN_MINUTE);
+		supervisorEnd(5);
 		// reset task flag
 		taskFlags &= ~0b00100000;
 	}
@@ -171,7 +326,11 @@ void checkForTask(void)
 	if (taskFlags & 0b01000000)
 	{
 		// run task
+		supervisorBegin(6);
+		PROFILE_BEGIN(PROFILE_TASK_THIRTY_MINUTE);
 		taskThirteenMinute();
+		PROFILE_END(PROFILE_TASK_THIRTY_MINUTE);
+		supervisorEnd(6);
 		// reset task flag
 		taskFlags &= ~0b01000000;
 	}
@@ -180,8 +339,148 @@ void checkForTask(void)
 	if (taskFlags & 0b10000000)
 	{
 		// run task
+		supervisorBegin(7);
+		PROFILE_BEGIN(PROFILE_TASK_HOUR);
 		taskHour();
+		PROFILE_END(PROFILE_TASK_HOUR);
+		supervisorEnd(7);
 		// reset task flag
 		taskFlags &= ~0b10000000;
 	}
+}
+
+//! Initialize deadline supervision and start the watchdog
+void initSupervisor(void)
+{
+	uint8_t i = 0;
+	
+	// record is not valid after power on
+	if((getResetFlags() & (1 << PORF)) || (supervisor.magic != SUPERVISOR_MAGIC))
+	{
+		supervisor.magic		= SUPERVISOR_MAGIC;
+		supervisor.task			= SUPERVISOR_IDLE;
+		supervisor.resetTask	= SUPERVISOR_IDLE;
+		supervisor.resets		= 0;
+		supervisor.sequence		= 0;
+		supervisor.resetSequence	= 0;
+		supervisor.stack		= 0;
+		supervisor.resetStack	= 0;
+	}
+	
+	// reset by watchdog: remember the hanging or late task
+	if(getResetFlags() & (1 << WDRF))
+	{
+		supervisor.resetTask		= supervisor.task;
+		supervisor.resetSequence	= supervisor.sequence;
+		supervisor.resetStack		= supervisor.stack;
+		if(supervisor.resets < 0xFF)
+		{
+			supervisor.resets++;
+		}
+	}
+	supervisor.task = SUPERVISOR_IDLE;
+	supervisor.stack = 0;
+	if(supervisor.sequence < 0xFF)
+	{
+		supervisor.sequence++;
+	}
+	
+	// all tasks start in time
+	supervisorSeconds = 0;
+	for(i = 0; i < 8; i++)
+	{
+		taskLastRun[i] = 0;
+	}
+	
+	// start watchdog (fuse WDTON is not programmed) with interrupt before reset
+	wdt_enable(WATCHDOG_TIMEOUT);
+	WDTCSR |= (1 << WDIE);
+}
+
+//! Count seconds of supervisor, called by timer 1 interrupt service routine
+void supervisorTick(void)
+{
+	supervisorSeconds++;
+}
+
+//! Check deadlines of all supervised tasks and feed the watchdog
+// called in every pass of the main loop
+void checkSupervisor(void)
+{
+	uint8_t i = 0;
+	
+	for(i = 0; i < 8; i++)
+	{
+		// task is supervised and last run is too old
+		if(taskDeadline[i] && ((uint8_t)(supervisorSeconds - taskLastRun[i]) > taskDeadline[i]))
+		{
+			// remember first late task and do not feed the watchdog anymore
+			if(!(supervisor.task & SUPERVISOR_MISSED))
+			{
+				supervisor.task = i | SUPERVISOR_MISSED;
+			}
+			return;
+		}
+	}
+	
+	// all deadlines are met (again): a late task caught up, the main loop
+	// runs outside of any task
+	if(supervisor.task & SUPERVISOR_MISSED)
+	{
+		supervisor.task = SUPERVISOR_IDLE;
+	}
+	wdt_reset();
+	// a watchdog interrupt clears WDIE, the reset would come without stack
+	WDTCSR |= (1 << WDIE);
+}
+
+//! Get task of last watchdog reset (SUPERVISOR_IDLE: no task)
+uint8_t getSupervisorResetTask(void)
+{
+	return supervisor.resetTask;
+}
+
+//! Get number of watchdog resets since power on
+uint8_t getSupervisorResets(void)
+{
+	return supervisor.resets;
+}
+
+//! Get start-up since power on, in which the last watchdog reset happened
+uint8_t getSupervisorResetSequence(void)
+{
+	return supervisor.resetSequence;
+}
+
+//! Get stack pointer of last watchdog reset (0: not saved)
+uint16_t getSupervisorResetStack(void)
+{
+	return supervisor.resetStack;
+}
+
+//! Watchdog timeout: save stack pointer, the next timeout resets the mcu
+// the stack pointer is a few bytes below the one of the interrupted code
+ISR(WDT_vect)
+{
+	supervisor.stack = SP;
+}
+
+//! Mark task as running
+static void supervisorBegin(uint8_t task)
+{
+	// a missed deadline is kept until the deadlines are met again
+	if(!(supervisor.task & SUPERVISOR_MISSED))
+	{
+		supervisor.task = task;
+	}
+}
+
+//! Mark task as finished and save time of run
+static void supervisorEnd(uint8_t task)
+{
+	if(task < 8)
+	{
+		taskLastRun[task] = supervisorSeconds;
+	}
+	supervisorBegin(SUPERVISOR_IDLE);
 }
\ No newline at end of file
@@ -13,8 +13,42 @@
 
 //! Libraries
 #include <stdint.h>
+#include <avr/wdt.h>
+#include <avr/interrupt.h>
+
+//! Supervisor Record (not initialized at start-up, survives a watchdog reset)
+struct supervisorRecord
+{
+	uint8_t magic;		// SUPERVISOR_MAGIC, if the record is valid
+	uint8_t task;		// actual task, bit 7 is set when a deadline was missed
+	uint8_t resetTask;	// task of last watchdog reset (see task)
+	uint8_t resets;		// number of watchdog resets since power on
+	uint8_t sequence;	// number of start-ups since power on
+	uint8_t resetSequence;	// start-up, in which the last watchdog reset happened
+	uint16_t stack;		// stack pointer in watchdog interrupt (0: no interrupt)
+	uint16_t resetStack;	// stack pointer of last watchdog reset (see stack)
+};
 
 //! Functional prototypes
 void initTasks(void);
 void calculateTaskTiming(void);
 void checkForTask(void);
+void checkForEvent(void);
+void checkForThreads(void);
+void initSupervisor(void);
+void supervisorTick(void);
+void checkSupervisor(void);
+uint8_t getSupervisorResetTask(void);
+uint8_t getSupervisorResets(void);
+uint8_t getSupervisorResetSequence(void);
+uint16_t getSupervisorResetStack(void);
+
+//! Supervisor
+// marker of a valid supervisor record
+#define SUPERVISOR_MAGIC		0xA5
+// task numbers (0 to 7 are equal to the bits of the task flags)
+#define SUPERVISOR_EVENTS		8		// event handling of main loop
+#define SUPERVISOR_THREADS		9		// threads of main loop
+#define SUPERVISOR_IDLE			0x7F	// no task is running
+// flag of a task, which has missed its deadline
+#define SUPERVISOR_MISSED		0x80
@@ -19,6 +19,9 @@
 #include "adc.h"
 #include "displayMatrix.h"
 #include "ledMatrix.h"
+#include "profiler.h"
+#include "brightness.h"
+#include "nightMgnt.h"
 
 //! Extern global variables
 extern volatile struct systemParameter systemConfig;
@@ -28,7 +31,8 @@ extern volatile struct row actualMatrix[12];
 //! Task hour
 void taskHour(void)
 {
-	
+	// learn range of light level
+	calibrateLightLevel();
 }
 
 //! Task hour
@@ -66,11 +70,15 @@ void taskSecond(void)
 {
 	// toggle status led
 	toggleStatusGreen();
+	// switch matrix to night mode or back
+	checkNightMgnt();
 }
 
 //! Task half second
 void taskHalfSecond(void)
 {
 	// display information on matrix, called by half second interrupt (time management)
-	displayMatrixInformation(0);
+	PROFILE_BEGIN(PROFILE_DISPLAY);
+	displayMatrixInformation();
+	PROFILE_END(PROFILE_DISPLAY);
 }
\ No newline at end of file
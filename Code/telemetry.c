@@ -0,0 +1,177 @@
+/*******************************************************************************
+*
+*	Author:			Georg Bauer
+*	Date:			18.10.2026
+*
+*	Project-Title:	ClockWise
+*	Description:	Binary telemetry stream on usart 0
+*
+*	File-Title:		Telemetry
+*
+*******************************************************************************
+*
+* Records of dcf77 reception (pulses, bits, decode results), adc values and
+* display brightness are sent as frames on usart 0:
+*	sync (0xA5), type, length, payload, crc-8 (ccitt) of type to payload
+* The stream is started and stopped with the console command 'tele on' and
+* 'tele off', the console output is sent between the frames (ascii text,
+* never 0xA5). Tools/telemetry.py receives and decodes the stream.
+*
+* Interrupt service routines don't write to usart 0, they post a sample to a
+* queue (postTelemetry(), single producer like the event queue, see
+* events.c) and threadTelemetry() frames it in the main loop. The main loop
+* frames its records directly (sendTelemetry()). A frame is only written,
+* if the transmit buffer of usart 0 has space for all of it, otherwise the
+* record is dropped and counted: the stream is limited by the serial line
+* and never waits for it.
+*
+*******************************************************************************
+*/
+
+//! Libraries
+#include "telemetry.h"
+#include "settings.h"
+#include "protothread.h"
+#include "usart.h"
+
+#ifdef TELEMETRY_ENABLED
+
+//! Own global variables
+// samples of interrupt service routines
+volatile struct telemetrySample telemetryQueue[TELEMETRY_QUEUE_SIZE];
+volatile uint8_t telemetryHead;		// write index, only changed by isr
+volatile uint8_t telemetryTail;		// read index, only changed by main loop
+// stream is active
+volatile uint8_t telemetryActive;
+// lost records (saturated)
+volatile uint8_t telemetryDropped;
+
+//! Initialize telemetry, the stream is inactive
+void initTelemetry(void)
+{
+	telemetryHead = 0;
+	telemetryTail = 0;
+	telemetryActive = 0;
+	telemetryDropped = 0;
+}
+
+//! Start (1) or stop (0) the stream
+void setTelemetry(uint8_t active)
+{
+	telemetryActive = active;
+}
+
+//! Get state of stream
+uint8_t getTelemetry(void)
+{
+	return telemetryActive;
+}
+
+//! Post a sample to the queue, only called from interrupt service routines
+// return value is '1', means sample is queued
+// return value is '0', means stream is inactive or queue is full
+uint8_t postTelemetry(uint8_t type, uint8_t data0, uint8_t data1, uint8_t data2)
+{
+	uint8_t head = telemetryHead;
+	volatile struct telemetrySample *sample = &telemetryQueue[head & (TELEMETRY_QUEUE_SIZE - 1)];
+	
+	if(!telemetryActive)
+	{
+		return 0;
+	}
+	
+	// queue full?
+	if((uint8_t)(head - telemetryTail) >= TELEMETRY_QUEUE_SIZE)
+	{
+		if(telemetryDropped < 255)
+		{
+			telemetryDropped++;
+		}
+		return 0;
+	}
+	
+	// write sample first and publish it afterwards
+	sample->type = type;
+	sample->data[0] = data0;
+	sample->data[1] = data1;
+	sample->data[2] = data2;
+	telemetryHead = head + 1;
+	
+	return 1;
+}
+
+//! Send a record as frame, only called from main loop
+// the record is dropped, if the transmit buffer has no space for the frame
+void sendTelemetry(uint8_t type, const uint8_t *data, uint8_t length)
+{
+	uint8_t crc = 0;
+	uint8_t i = 0;
+	
+	if(!telemetryActive)
+	{
+		return;
+	}
+	
+	if(getUsart0Free() < length + TELEMETRY_FRAME_SIZE)
+	{
+		// counter is changed by isr as well
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			if(telemetryDropped < 255)
+			{
+				telemetryDropped++;
+			}
+		}
+		return;
+	}
+	
+	usart0Transmit(TELEMETRY_SYNC);
+	usart0Transmit(type);
+	crc = _crc8_ccitt_update(crc, type);
+	usart0Transmit(length);
+	crc = _crc8_ccitt_update(crc, length);
+	for(i = 0; i < length; i++)
+	{
+		usart0Transmit(data[i]);
+		crc = _crc8_ccitt_update(crc, data[i]);
+	}
+	usart0Transmit(crc);
+}
+
+//! thread: frame samples of interrupt service routines and report lost records
+uint8_t threadTelemetry(void)
+{
+	static struct pt pt;
+	static uint8_t reported;
+	uint8_t tail = 0;
+	uint8_t data[3];
+	
+	PT_BEGIN(&pt);
+	
+	while(1)
+	{
+		PT_WAIT_UNTIL(&pt, (telemetryTail != telemetryHead) || (telemetryDropped != reported));
+		
+		// new lost records (the report can get lost as well)
+		if(telemetryDropped != reported)
+		{
+			reported = telemetryDropped;
+			sendTelemetry(TELEMETRY_DROPPED, &reported, 1);
+		}
+		
+		// oldest sample
+		tail = telemetryTail;
+		if(tail != telemetryHead)
+		{
+			data[0] = telemetryQueue[tail & (TELEMETRY_QUEUE_SIZE - 1)].data[0];
+			data[1] = telemetryQueue[tail & (TELEMETRY_QUEUE_SIZE - 1)].data[1];
+			data[2] = telemetryQueue[tail & (TELEMETRY_QUEUE_SIZE - 1)].data[2];
+			sendTelemetry(telemetryQueue[tail & (TELEMETRY_QUEUE_SIZE - 1)].type, data, 3);
+			telemetryTail = tail + 1;
+		}
+	}
+	
+	PT_END(&pt);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,46 @@
+/*******************************************************************************
+*
+*	Author:			Georg Bauer
+*	Date:			18.10.2026
+*
+*	Project-Title:	ClockWise
+*	Description:	Binary telemetry stream on usart 0
+*
+*	File-Title:		Telemetry - Header File
+*
+*******************************************************************************
+*/
+
+//! Libraries
+#include <avr/io.h>
+#include <util/crc16.h>
+#include <util/atomic.h>
+#include <stdint.h>
+
+//! Sample of an interrupt service routine (sent by threadTelemetry())
+struct telemetrySample
+{
+	uint8_t type;		// record type (see TELEMETRY_*)
+	uint8_t data[3];	// payload of record
+};
+
+//! Functional prototypes
+void initTelemetry(void);
+void setTelemetry(uint8_t active);
+uint8_t getTelemetry(void);
+uint8_t postTelemetry(uint8_t type, uint8_t data0, uint8_t data1, uint8_t data2);
+void sendTelemetry(uint8_t type, const uint8_t *data, uint8_t length);
+uint8_t threadTelemetry(void);
+
+//! Frame: sync, type, length, payload, crc-8 (ccitt) of type, length and payload
+#define TELEMETRY_SYNC				0xA5	// first byte of frame
+#define TELEMETRY_FRAME_SIZE		4		// frame bytes without payload
+
+//! Record types (payload, 16 bit values little endian)
+#define TELEMETRY_DCF_EDGE			1	// start of dcf77 pulse: system ticks (2), timer 0 (1, 64us)
+#define TELEMETRY_DCF_BIT			2	// end of dcf77 pulse: bit index (1), width in timer 0 steps (2, 64us, bit 15: value)
+#define TELEMETRY_DCF_MINUTE		3	// minute gap: received bits (1), system ticks (2)
+#define TELEMETRY_DCF_DECODE		4	// decoded frame: result (1, 0 or LOG_DCF_*), accepted: hour, minute, day, month, year, weekday
+#define TELEMETRY_ADC				5	// filtered adc value: channel (1), value (2)
+#define TELEMETRY_BRIGHTNESS		6	// light level, potentiometer, perceived lightness, pwm value (1 each)
+#define TELEMETRY_DROPPED			7	// lost records since start (1, saturated)
\ No newline at end of file
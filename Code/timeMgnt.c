@@ -14,12 +14,28 @@
 *
 *******************************************************************************
 *
+* Pin Declaration:
+*	Pin						| Description
+*	------------------------|-------------------------------------------------
+*	PA6 (Pin 34) as input	| SQW/OUT of rtc (1Hz, open drain, pullup)
+*	------------------------|-------------------------------------------------
+*
+*******************************************************************************
+*
 *	Timer:
 *	Timer 1 is used for counting seconds and calculate time
+*	Timer 0 (dcf77 sampling) counts the system ticks (16,384ms)
 *
 *	Interrupts:
 *	Timer 1 interrupt service routine is every second active
 *
+*	Square wave timebase (see enableSqwTimebase()):
+*	The falling edge of the 1Hz square wave of the rtc (PCINT6) counts the
+*	seconds, its crystal is more stable and runs without the mcu. Timer 1 is
+*	restarted at every edge and only interpolates within the second. Without
+*	an edge timer 1 overflows after 1,048s: the second is counted by timer 1
+*	and the timebase falls back to timer 1.
+*
 *******************************************************************************
 */
 
@@ -28,12 +44,21 @@
 #include "system.h"
 #include "gpios.h"
 #include "ledMatrix.h"
+#include "events.h"
 #include "taskMgnt.h"
 
 //! Extern globals variables
 extern volatile struct time systemTime;
 extern volatile struct systemParameter systemConfig;
 
+//! Own global variables
+// timebase of seconds (see TIMEBASE_*)
+volatile uint8_t timebase;
+// lost square wave pulses (saturated)
+volatile uint8_t sqwFailures;
+// system ticks, incremented by timer 0 every 16,384ms
+volatile uint16_t systemTicks;
+
 //! Write Initial values
 void initTimeMgnt(void)
 {
@@ -45,23 +70,89 @@ void initTimeMgnt(void)
 	TIMSK1 |= (1 << TOIE1);
 	// preload timing value
 	TCNT1 = 3036;
+	
+	// seconds of timer 1 until the square wave is enabled
+	timebase = TIMEBASE_TIMER1;
+	sqwFailures = 0;
 }
 
-//! Interrupt Service Routine for when Timer/Counter 1 has an overflow
-// this routine will called every 1s (1Hz)
-// calculated by: (2^16 [16bit counter]  - 3036 [preload value]) * 256 [timer 1 clock divider] / 16MHz = 1s
-ISR(TIMER1_OVF_vect)
+//! Enable square wave of rtc (1Hz) as timebase of seconds
+// the square wave output has to be enabled in the rtc (see enableRtcSquareWave())
+// the first falling edge takes over from timer 1 (see PCINT0_vect)
+void enableSqwTimebase(void)
 {
-	uint8_t newMonth = 0;
+	// PA6 as input with pullup (open drain output of rtc)
+	DDRA &= ~(1 << PA6);
+	PORTA |= (1 << PA6);
 	
-	// preload timing value
-	TCNT1 = 3036;
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		timebase = TIMEBASE_SQW_ARMED;
+		// enabled pin change interrupts PCINT7:0, activate PA6 (PCINT6)
+		PCMSK0 |= (1 << PCINT6);
+		PCIFR |= (1 << PCIF0);
+		PCICR |= (1 << PCIE0);
+	}
+}
+
+//! Get timebase of seconds (see TIMEBASE_*)
+uint8_t getTimebase(void)
+{
+	return timebase;
+}
+
+//! Get number of lost square wave pulses (saturated)
+uint8_t getSqwFailures(void)
+{
+	return sqwFailures;
+}
+
+//! Get time within actual second in ms (range 0 to 999), interpolated by timer 1
+uint16_t getSubSecond(void)
+{
+	uint16_t ticks = 0;
+	
+	// 16 bit register, timer 1 is preloaded by interrupt service routines
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		ticks = TCNT1;
+		// timer 1 starts at 0 (square wave) or 3036 (timer 1)
+		if(timebase != TIMEBASE_SQW)
+		{
+			ticks -= 3036;
+		}
+	}
+	
+	// 62500 ticks per second (16us)
+	ticks = ((uint32_t)ticks * 2) / 125;
+	return (ticks < 1000) ? ticks : 999;
+}
+
+//! Get system ticks (16,384ms), used as time base for protothreads
+uint16_t getSystemTicks(void)
+{
+	uint16_t ticks = 0;
+	
+	// 16 bit value is changed by interrupt service routine
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		ticks = systemTicks;
+	}
+	return ticks;
+}
+
+//! Count a second and calculate time, called by timer 1 or the square wave
+void countSecond(void)
+{
+	uint8_t newMonth = 0;
 	
 	// increment seconds
 	systemTime.second++;
 	
-	// calculate actual task
-	calculateTaskTiming();
+	// tell main loop to calculate actual task
+	postEvent(EVENT_TICK, 0);
+	// count seconds for deadline supervision
+	supervisorTick();
 		
 	// calculate other time parameter
 	if (systemTime.second >= 60)
@@ -123,4 +214,64 @@ ISR(TIMER1_OVF_vect)
 			}
 		}
 	}
+}
+
+//! Interrupt Service Routine for when Timer/Counter 1 has an overflow
+// this routine will called every 1s (1Hz)
+// calculated by: (2^16 [16bit counter]  - 3036 [preload value]) * 256 [timer 1 clock divider] / 16MHz = 1s
+ISR(TIMER1_OVF_vect)
+{
+	// square wave timebase: no edge for 1,048s, the pulse is lost
+	if(timebase == TIMEBASE_SQW)
+	{
+		// back to timer 1, the second was due 48ms ago (3036 ticks)
+		TCNT1 = 2 * 3036;
+		timebase = TIMEBASE_TIMER1;
+		PCMSK0 &= ~(1 << PCINT6);
+		if(sqwFailures < 255)
+		{
+			sqwFailures++;
+		}
+	}
+	else
+	{
+		// preload timing value
+		TCNT1 = 3036;
+	}
+	
+	countSecond();
+}
+
+//! Interrupt Service Routine for when the square wave of the rtc changes
+// this routine will called every 0,5s (both edges of 1Hz)
+ISR(PCINT0_vect)
+{
+	// only falling edge
+	if(PINA & (1 << PA6))
+	{
+		return;
+	}
+	
+	if(timebase == TIMEBASE_SQW)
+	{
+		countSecond();
+	}
+	else if(timebase == TIMEBASE_SQW_ARMED)
+	{
+		// take over from timer 1: its second is counted now,
+		// if more than the half of it has passed
+		if(TCNT1 >= 3036 + 31250)
+		{
+			countSecond();
+		}
+		timebase = TIMEBASE_SQW;
+	}
+	else
+	{
+		return;
+	}
+	
+	// timer 1 interpolates the second from now on
+	TCNT1 = 0;
+	TIFR1 = (1 << TOV1);
 }
\ No newline at end of file
@@ -16,6 +16,18 @@
 #include <avr/interrupt.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <util/atomic.h>
 
 //! Functional prototypes
-void initTimeMgnt(void);
\ No newline at end of file
+void initTimeMgnt(void);
+uint16_t getSystemTicks(void);
+void enableSqwTimebase(void);
+uint8_t getTimebase(void);
+uint8_t getSqwFailures(void);
+uint16_t getSubSecond(void);
+void countSecond(void);
+
+//! Timebase of seconds
+#define TIMEBASE_TIMER1			0	// timer 1 (16MHz crystal)
+#define TIMEBASE_SQW_ARMED		1	// timer 1, square wave takes over at next edge
+#define TIMEBASE_SQW			2	// square wave of rtc (32,768kHz crystal)
\ No newline at end of file
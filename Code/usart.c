@@ -17,11 +17,24 @@
 *	PD3 (Pin 17) as output	| TXD USART 1 for LED Matrix
 *	PD2 (Pin 38) as output	| XCK USART 1 for LED Matrix
 *	------------------------|-------------------------------------------------
+*	PD0 (Pin 14) as input	| RXD USART 0 for serial output
+*	PD1 (Pin 15) as output	| TXD USART 0 for serial output (see settings.h)
+*	------------------------|-------------------------------------------------
 *
 *******************************************************************************
 *
 * UART1 in SPI Mode works @800kHz
 *
+* UART0 works @38400 baud (8N1)
+*
+* UART0 is interrupt driven with a transmit and a receive ring buffer (see
+* settings.h). Like the event queue (see events.c) both are single-producer/
+* single-consumer buffers with free running 8 bit indices:
+* - transmit: main loop writes, data register empty interrupt reads
+* - receive: receive complete interrupt writes, main loop reads
+* A full transmit buffer drops the output, so a print never waits for the
+* serial line. A full receive buffer drops the received byte.
+*
 * Settings to decode with Saleae Logic Analyzer:
 * 
 *******************************************************************************
@@ -29,6 +42,19 @@
 
 //! Libraries
 #include "usart.h"
+#include "settings.h"
+
+//! Own global variables
+// transmit ring buffer of usart 0
+volatile uint8_t usart0TxBuffer[USART0_TX_BUFFER_SIZE];
+volatile uint8_t usart0TxHead;		// write index, only changed by main loop
+volatile uint8_t usart0TxTail;		// read index, only changed by isr
+// receive ring buffer of usart 0
+volatile uint8_t usart0RxBuffer[USART0_RX_BUFFER_SIZE];
+volatile uint8_t usart0RxHead;		// write index, only changed by isr
+volatile uint8_t usart0RxTail;		// read index, only changed by main loop
+// bytes lost on a full buffer (saturated)
+volatile uint8_t usart0Dropped;
 
 //! Initialize Usart 1
 void initUsart(void)
@@ -58,3 +84,148 @@ void usartReceiveTransmit(uint8_t data)
 	return UDR1;
 	*/
 }
+
+
+//! Initialize Usart 0
+void initUsart0(void)
+{
+	// set baud rate = fosc / (16 * (UBRR + 1)) = 38400 baud
+	UBRR0 = USART0_UBRR;
+	// asynchronous mode, 8 data bits, no parity, 1 stop bit
+	UCSR0C = (1 << UCSZ01) | (1 << UCSZ00);
+	// empty ring buffers
+	usart0TxHead = 0;
+	usart0TxTail = 0;
+	usart0RxHead = 0;
+	usart0RxTail = 0;
+	usart0Dropped = 0;
+	// Enable receiver with interrupt and transmitter
+	// (data register empty interrupt is enabled with the first byte)
+	UCSR0B = (1 << RXCIE0) | (1 << RXEN0) | (1 << TXEN0);
+}
+
+//! Send one byte via usart 0 (written to transmit buffer)
+void usart0Transmit(uint8_t data)
+{
+	uint8_t head = usart0TxHead;
+	
+	// buffer full: drop byte
+	if((uint8_t)(head - usart0TxTail) >= USART0_TX_BUFFER_SIZE)
+	{
+		if(usart0Dropped < 255)
+		{
+			usart0Dropped++;
+		}
+		return;
+	}
+	
+	usart0TxBuffer[head & (USART0_TX_BUFFER_SIZE - 1)] = data;
+	usart0TxHead = head + 1;
+	// start sending (the isr stops itself at an empty buffer)
+	UCSR0B |= (1 << UDRIE0);
+}
+
+//! Send one byte as two hexadecimal characters via usart 0
+void usart0TransmitHex(uint8_t data)
+{
+	uint8_t nibble = data >> 4;
+	usart0Transmit(nibble < 10 ? '0' + nibble : 'A' - 10 + nibble);
+	nibble = data & 0x0F;
+	usart0Transmit(nibble < 10 ? '0' + nibble : 'A' - 10 + nibble);
+}
+
+//! Send text from flash memory via usart 0
+void usart0TransmitText(const char *text)
+{
+	char character = pgm_read_byte(text);
+	
+	while(character)
+	{
+		usart0Transmit(character);
+		text++;
+		character = pgm_read_byte(text);
+	}
+}
+
+//! Send value as decimal number with at least 'digits' digits via usart 0
+void usart0TransmitNumber(uint16_t value, uint8_t digits)
+{
+	char buffer[5];
+	uint8_t i = 0;
+	
+	// digits from right to left
+	do
+	{
+		buffer[i++] = '0' + value % 10;
+		value /= 10;
+	}
+	while(value || (i < digits && i < sizeof(buffer)));
+	
+	while(i)
+	{
+		usart0Transmit(buffer[--i]);
+	}
+}
+
+//! Get next received byte of usart 0
+// return value is '1', means a byte was read to 'data'
+// return value is '0', means receive buffer is empty
+uint8_t usart0Receive(uint8_t *data)
+{
+	uint8_t tail = usart0RxTail;
+	
+	if(tail == usart0RxHead)
+	{
+		return 0;
+	}
+	*data = usart0RxBuffer[tail & (USART0_RX_BUFFER_SIZE - 1)];
+	usart0RxTail = tail + 1;
+	return 1;
+}
+
+//! Get free space of transmit buffer in bytes
+uint8_t getUsart0Free(void)
+{
+	return USART0_TX_BUFFER_SIZE - (uint8_t)(usart0TxHead - usart0TxTail);
+}
+
+//! Get number of bytes lost on a full buffer
+uint8_t getUsart0Dropped(void)
+{
+	return usart0Dropped;
+}
+
+//! Interrupt Service Routine for empty data register of usart 0
+// sends next byte of transmit buffer
+ISR(USART0_UDRE_vect)
+{
+	uint8_t tail = usart0TxTail;
+	
+	// buffer empty: stop interrupt
+	if(tail == usart0TxHead)
+	{
+		UCSR0B &= ~(1 << UDRIE0);
+		return;
+	}
+	UDR0 = usart0TxBuffer[tail & (USART0_TX_BUFFER_SIZE - 1)];
+	usart0TxTail = tail + 1;
+}
+
+//! Interrupt Service Routine for received byte of usart 0
+ISR(USART0_RX_vect)
+{
+	uint8_t head = usart0RxHead;
+	uint8_t data = UDR0;
+	
+	// buffer full: drop byte
+	if((uint8_t)(head - usart0RxTail) >= USART0_RX_BUFFER_SIZE)
+	{
+		if(usart0Dropped < 255)
+		{
+			usart0Dropped++;
+		}
+		return;
+	}
+	usart0RxBuffer[head & (USART0_RX_BUFFER_SIZE - 1)] = data;
+	usart0RxHead = head + 1;
+}
\ No newline at end of file
@@ -13,8 +13,18 @@
 
 //! Libraries
 #include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
 #include <stdint.h>
 
 //! Functional prototypes
 void initUsart(void);
-void usartReceiveTransmit(uint8_t data);
\ No newline at end of file
+void usartReceiveTransmit(uint8_t data);
+void initUsart0(void);
+void usart0Transmit(uint8_t data);
+void usart0TransmitHex(uint8_t data);
+void usart0TransmitText(const char *text);
+void usart0TransmitNumber(uint16_t value, uint8_t digits);
+uint8_t usart0Receive(uint8_t *data);
+uint8_t getUsart0Free(void);
+uint8_t getUsart0Dropped(void);
\ No newline at end of file
@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+"""Decode the ClockWise event log (see Code/log.c).
+
+The log is a ring buffer of 8 byte entries in eeprom:
+
+    sequence (1) | code (1) | payload (2, little endian) | time (4, little endian)
+
+time is the packed system time (bit 31..26 year, 25..22 month, 21..17 day,
+16..12 hour, 11..6 minute, 5..0 second), 0 means no time was available.
+The year has 6 bits and wraps in 2064.
+
+Input is one of:
+  - the serial dump of the console command "log" or the debug menu (DBG4, ok),
+    lines "L xx xx xx xx xx xx xx xx"
+  - an eeprom image read by avrdude, raw binary or intel hex:
+        avrdude -p m1284p -c <programmer> -U eeprom:r:eeprom.bin:r
+    the position of the ring buffer is set by the linker, get it with
+        avr-nm ClockWisePaps.elf | grep eepromLog
+    (address minus 0x810000) and pass it as --offset
+
+Usage:
+    logdecode.py dump.txt
+    logdecode.py --offset 0x38 eeprom.bin
+"""
+
+import argparse
+import struct
+import sys
+
+ENTRY_SIZE = 8
+EVENT_NONE = 0xFF
+
+EVENTS = {
+    1: "reset",
+    2: "dcf77 sync",
+    3: "dcf77 fail",
+    4: "manual time",
+    5: "supply low",
+    6: "rtc error",
+    7: "rtc write",
+    8: "watchdog",
+    9: "watchdog stack",
+}
+
+DCF_REASONS = {
+    1: "parity minute",
+    2: "parity hour",
+    3: "parity date",
+    4: "plausibility",
+}
+
+RESET_FLAGS = [(0x01, "power on"), (0x02, "external"), (0x04, "brown out"),
+               (0x08, "watchdog"), (0x10, "jtag")]
+
+
+def unpack_time(value):
+    if value == 0:
+        return "--.--.-- --:--:--"
+    year = (value >> 26) & 0x3F
+    month = (value >> 22) & 0x0F
+    day = (value >> 17) & 0x1F
+    hour = (value >> 12) & 0x1F
+    minute = (value >> 6) & 0x3F
+    second = value & 0x3F
+    return "%02d.%02d.%02d %02d:%02d:%02d" % (day, month, year, hour, minute, second)
+
+
+def describe(code, payload):
+    if code == 1:
+        flags = [name for bit, name in RESET_FLAGS if payload & bit]
+        return ", ".join(flags) if flags else "no flags"
+    if code == 3:
+        return "%d frames, last: %s" % (payload >> 8, DCF_REASONS.get(payload & 0xFF, "?"))
+    if code == 5:
+        return "%d mV" % payload
+    if code == 6:
+        return "bus errors %d, retries %d" % (payload >> 8, payload & 0xFF)
+    if code == 8:
+        task = payload >> 8
+        name = "idle" if task & 0x7F == 0x7F else "task %d" % (task & 0x7F)
+        return "%s%s, start-up %d" % (name, " (deadline missed)" if task & 0x80 else "", payload & 0xFF)
+    if code == 9:
+        return "stack 0x%04X" % payload if payload else "stack not saved"
+    return "0x%04X" % payload if payload else ""
+
+
+def parse_entry(data):
+    return struct.unpack("<BBHI", bytes(data))
+
+
+def read_dump(lines):
+    entries = []
+    for line in lines:
+        fields = line.split()
+        if len(fields) == ENTRY_SIZE + 1 and fields[0] == "L":
+            entries.append(parse_entry(int(f, 16) for f in fields[1:]))
+    # the dump is sent oldest first
+    return entries
+
+
+def read_intel_hex(lines):
+    image = {}
+    base = 0
+    for line in lines:
+        line = line.strip()
+        if not line.startswith(":"):
+            continue
+        record = bytes.fromhex(line[1:])
+        length, address, kind = record[0], (record[1] << 8) | record[2], record[3]
+        if kind == 0:
+            for i in range(length):
+                image[base + address + i] = record[4 + i]
+        elif kind == 2:
+            base = ((record[4] << 8) | record[5]) << 4
+        elif kind == 4:
+            base = ((record[4] << 8) | record[5]) << 16
+    size = max(image) + 1 if image else 0
+    return bytes(image.get(i, 0xFF) for i in range(size))
+
+
+def read_image(image, offset, count):
+    entries = []
+    for i in range(count):
+        start = offset + i * ENTRY_SIZE
+        if start + ENTRY_SIZE > len(image):
+            break
+        entries.append(parse_entry(image[start:start + ENTRY_SIZE]))
+    # same search as initLog(): first empty entry or break of sequence
+    head = 0
+    for i, entry in enumerate(entries):
+        if entry[1] == EVENT_NONE or (i and entry[0] != (entries[i - 1][0] + 1) & 0xFF):
+            head = i
+            break
+    ordered = entries[head:] + entries[:head]
+    return [entry for entry in ordered if entry[1] != EVENT_NONE]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("file", help="serial dump, raw eeprom image or intel hex")
+    parser.add_argument("--offset", type=lambda v: int(v, 0), default=None,
+                        help="eeprom address of the ring buffer (eepromLog)")
+    parser.add_argument("--entries", type=int, default=128,
+                        help="entries of the ring buffer (LOG_ENTRIES)")
+    args = parser.parse_args()
+
+    with open(args.file, "rb") as handle:
+        content = handle.read()
+
+    text = content.decode("ascii", errors="replace")
+    if args.offset is None:
+        entries = read_dump(text.splitlines())
+    else:
+        if text.lstrip().startswith(":"):
+            content = read_intel_hex(text.splitlines())
+        entries = read_image(content, args.offset, args.entries)
+
+    if not entries:
+        sys.exit("no log entries found")
+
+    for sequence, code, payload, time in entries:
+        print("%3d  %s  %-12s %s" % (sequence, unpack_time(time),
+                                    EVENTS.get(code, "event %d" % code),
+                                    describe(code, payload)))
+
+
+if __name__ == "__main__":
+    main()
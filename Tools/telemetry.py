@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+"""Receive and decode the ClockWise telemetry stream (see Code/telemetry.c).
+
+The firmware has to be built with USART0_ENABLED and TELEMETRY_ENABLED. Every
+record is a frame on usart 0 (38400 baud, 8N1):
+
+    0xA5 | type | length | payload | crc-8 (ccitt, poly 0x07) of type .. payload
+
+Console text between the frames is shown as comment lines (or dropped with
+--quiet). Frames with a wrong length or crc are skipped byte by byte.
+
+Usage:
+    telemetry.py --port /dev/ttyUSB0 [--save capture.bin]   live, sends 'tele on'
+    telemetry.py capture.bin                                 recorded stream
+    telemetry.py --csv capture.bin > capture.csv
+
+Timing of dcf77 pulses: timer 0 (64us steps) is restarted at every pulse
+start and its overflows (16.384ms) are the system ticks, so the time since
+the last pulse start is (ticks - last ticks) * 16.384ms + timer * 0.064ms.
+The width of a pulse is captured at its end in timer 0 steps as well.
+"""
+
+import argparse
+import sys
+
+SYNC = 0xA5
+MAX_PAYLOAD = 16
+TICK_MS = 16.384
+TIMER_MS = 0.064
+
+DCF_RESULTS = {
+    0: "accepted",
+    1: "parity minute",
+    2: "parity hour",
+    3: "parity date",
+    4: "plausibility",
+}
+
+ADC_CHANNELS = {0: "vdr", 1: "trimmer", 2: "bandgap"}
+
+
+def crc8(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+class Decoder:
+    """Splits a byte stream into frames and console text."""
+
+    def __init__(self):
+        self.buffer = bytearray()
+
+    def feed(self, data):
+        """Yield ('frame', type, payload) or ('text', line) items."""
+        self.buffer.extend(data)
+        text = bytearray()
+        while self.buffer:
+            if self.buffer[0] != SYNC:
+                text.append(self.buffer.pop(0))
+                continue
+            if len(self.buffer) < 3:
+                break
+            length = self.buffer[2]
+            if length > MAX_PAYLOAD:
+                self.buffer.pop(0)
+                continue
+            if len(self.buffer) < length + 4:
+                break
+            frame = self.buffer[1:length + 3]
+            if crc8(frame) != self.buffer[length + 3]:
+                self.buffer.pop(0)
+                continue
+            del self.buffer[:length + 4]
+            if text:
+                yield ("text", text.decode("ascii", errors="replace"))
+                text = bytearray()
+            yield ("frame", frame[0], bytes(frame[2:]))
+        if text:
+            yield ("text", text.decode("ascii", errors="replace"))
+
+
+class Formatter:
+    """Turns records into text or csv lines."""
+
+    def __init__(self, csv):
+        self.csv = csv
+        self.last_edge = None
+
+    def line(self, name, fields):
+        if self.csv:
+            return ",".join([name] + ["%s" % value for _, value in fields])
+        return "%-10s " % name + " ".join("%s=%s" % field for field in fields)
+
+    def record(self, kind, payload):
+        if kind == 1 and len(payload) >= 3:
+            ticks = payload[0] | payload[1] << 8
+            timer = payload[2]
+            fields = [("ticks", ticks), ("timer", timer)]
+            if self.last_edge is not None:
+                interval = ((ticks - self.last_edge) & 0xFFFF) * TICK_MS + timer * TIMER_MS
+                fields.append(("interval_ms", "%.1f" % interval))
+            self.last_edge = ticks
+            return self.line("edge", fields)
+        if kind == 2 and len(payload) >= 3:
+            width = payload[1] | payload[2] << 8
+            return self.line("bit", [("index", payload[0]), ("value", width >> 15),
+                                     ("width_ms", "%.3f" % ((width & 0x7FFF) * TIMER_MS))])
+        if kind == 3 and len(payload) >= 3:
+            return self.line("minute", [("bits", payload[0]),
+                                        ("ticks", payload[1] | payload[2] << 8)])
+        if kind == 4 and payload:
+            fields = [("result", DCF_RESULTS.get(payload[0], payload[0]))]
+            if payload[0] == 0 and len(payload) >= 7:
+                fields.append(("time", "%02d:%02d %02d.%02d.%02d weekday %d" % (
+                    payload[1], payload[2], payload[3], payload[4], payload[5], payload[6])))
+            return self.line("decode", fields)
+        if kind == 5 and len(payload) >= 3:
+            return self.line("adc", [("channel", ADC_CHANNELS.get(payload[0], payload[0])),
+                                     ("value", payload[1] | payload[2] << 8)])
+        if kind == 6 and len(payload) >= 4:
+            return self.line("bright", [("light", payload[0]), ("trimmer", payload[1]),
+                                        ("level", payload[2]), ("pwm", payload[3])])
+        if kind == 7 and payload:
+            return self.line("dropped", [("count", payload[0])])
+        return self.line("type%d" % kind, [("payload", payload.hex())])
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("file", nargs="?", help="recorded stream (raw bytes)")
+    parser.add_argument("--port", help="serial port of usart 0 (needs pyserial)")
+    parser.add_argument("--baud", type=int, default=38400)
+    parser.add_argument("--save", help="write the raw stream of the port to a file")
+    parser.add_argument("--csv", action="store_true", help="comma separated output")
+    parser.add_argument("--quiet", action="store_true", help="hide console text")
+    args = parser.parse_args()
+
+    if not args.file and not args.port:
+        parser.error("a file or --port is needed")
+
+    decoder = Decoder()
+    formatter = Formatter(args.csv)
+
+    def show(data):
+        for item in decoder.feed(data):
+            if item[0] == "frame":
+                print(formatter.record(item[1], item[2]), flush=True)
+            elif not args.quiet and item[1].strip():
+                for text in item[1].splitlines():
+                    if text.strip():
+                        print("# " + text.strip(), flush=True)
+
+    if args.file:
+        with open(args.file, "rb") as handle:
+            show(handle.read())
+        return
+
+    import serial
+
+    save = open(args.save, "wb") if args.save else None
+    port = serial.Serial(args.port, args.baud, timeout=0.2)
+    try:
+        port.write(b"\rtele on\r")
+        while True:
+            data = port.read(256)
+            if data:
+                if save:
+                    save.write(data)
+                show(data)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        port.write(b"tele off\r")
+        port.close()
+        if save:
+            save.close()
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,250 @@
+#!/usr/bin/env python3
+"""Update the ClockWise firmware with the serial bootloader (see Bootloader/bootloader.c).
+
+The bootloader is programmed once via SPI (BOOTRST programmed, see the fuse
+settings in Code/main.c). Afterwards the application is updated on usart 0
+(38400 baud, 8N1) with the hex file of Atmel Studio (Release/ClockWisePaps.hex).
+
+The bootloader waits for a host after power up or a reset (100ms), after the
+console command 'boot' (10s) or forever, if there is no application. This
+tool sends 'boot' first (ignored without console) and repeats the sync frame
+until the bootloader answers, so a reset by hand works as well.
+
+Hardware: TXD0 (PD1) drives the reset signal RSTREG of the led matrix as
+well, RSTREG has to be tied to +5V before usart 0 is used (see
+Code/settings.h).
+
+Entry: the console command 'boot' needs firmware built with USART0_ENABLED
+(disabled by default). Otherwise run the tool with --no-console and switch
+the clock off and on (or reset it) within --wait seconds.
+
+Frames (16 bit values little endian, crc-16 xmodem of command to payload):
+
+    host:       command | page (2) | payload | crc (2)
+    bootloader: status | payload | crc (2) of payload (only with payload)
+
+    S sync      reply: version, signature (3), application pages (2), page size (2)
+    W write     payload: page data, the bootloader verifies the page after writing
+    R read      reply: page data
+    G go        starts the application
+
+Page 0 (reset vector) is erased first and written last, so an interrupted
+update leaves the bootloader waiting after the next reset. All pages are read
+back and compared at the end (skip with --no-verify).
+
+Usage:
+    upload.py --port /dev/ttyUSB0 ClockWisePaps.hex
+    upload.py --port COM3 --no-console --wait 60 ClockWisePaps.hex   power cycle by hand
+"""
+
+import argparse
+import sys
+import time
+
+SIGNATURE = bytes([0x1E, 0x97, 0x05])   # ATmega1284P
+SYNC_SIZE = 8
+RETRIES = 5
+
+REPLY_OK = b"K"
+REPLY_ERROR = b"E"
+
+
+class UploadError(Exception):
+    pass
+
+
+def crc16(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def read_hex(path):
+    """Read an Intel hex file, return {address: byte}."""
+    memory = {}
+    base = 0
+    with open(path) as handle:
+        for number, line in enumerate(handle, 1):
+            line = line.strip()
+            if not line:
+                continue
+            if not line.startswith(":"):
+                raise UploadError("%s:%d: no hex record" % (path, number))
+            try:
+                record = bytes.fromhex(line[1:])
+            except ValueError:
+                raise UploadError("%s:%d: no hex record" % (path, number))
+            if len(record) < 5 or len(record) != record[0] + 5 or sum(record) & 0xFF:
+                raise UploadError("%s:%d: broken hex record" % (path, number))
+            length, address, kind = record[0], record[1] << 8 | record[2], record[3]
+            data = record[4:4 + length]
+            if kind == 0:
+                for offset, byte in enumerate(data):
+                    memory[base + address + offset] = byte
+            elif kind == 1:
+                break
+            elif kind == 2:
+                base = (data[0] << 8 | data[1]) << 4
+            elif kind == 4:
+                base = (data[0] << 8 | data[1]) << 16
+    return memory
+
+
+def split_pages(memory, page_size):
+    """Return the pages from 0 to the last used page, unused bytes are 0xFF."""
+    if not memory:
+        raise UploadError("hex file has no data")
+    count = max(memory) // page_size + 1
+    image = bytearray(b"\xFF" * count * page_size)
+    for address, byte in memory.items():
+        image[address] = byte
+    return [bytes(image[page * page_size:(page + 1) * page_size]) for page in range(count)]
+
+
+class Bootloader:
+    """Frames and retries of the bootloader protocol."""
+
+    def __init__(self, port):
+        self.port = port
+        self.page_size = 0
+        self.pages = 0
+
+    @staticmethod
+    def frame(command, page, payload=b""):
+        data = command + bytes([page & 0xFF, page >> 8]) + payload
+        return data + crc16(data).to_bytes(2, "little")
+
+    def sync(self, wait):
+        """Send sync frames until the bootloader answers, return its version."""
+        frame = self.frame(b"S", 0)
+        received = bytearray()
+        deadline = time.time() + wait
+        while time.time() < deadline:
+            self.port.write(frame)
+            received += self.port.read(64)
+            start = received.find(REPLY_OK)
+            while start >= 0 and len(received) >= start + SYNC_SIZE + 3:
+                info = received[start + 1:start + SYNC_SIZE + 1]
+                crc = received[start + SYNC_SIZE + 1:start + SYNC_SIZE + 3]
+                if crc16(info) == int.from_bytes(crc, "little"):
+                    # replies of further sync frames
+                    time.sleep(0.2)
+                    self.port.reset_input_buffer()
+                    if info[1:4] != SIGNATURE:
+                        raise UploadError("wrong device signature %s" % info[1:4].hex())
+                    self.pages = info[4] | info[5] << 8
+                    self.page_size = info[6] | info[7] << 8
+                    return info[0]
+                start = received.find(REPLY_OK, start + 1)
+            del received[:-(SYNC_SIZE + 2)]
+        raise UploadError("no answer of bootloader")
+
+    def command(self, command, page, payload=b"", reply=0):
+        """Send a frame (again on a wrong crc or timeout), return the reply payload."""
+        frame = self.frame(command, page, payload)
+        for _ in range(RETRIES):
+            self.port.reset_input_buffer()
+            self.port.write(frame)
+            status = self.port.read(1)
+            if status == REPLY_OK:
+                if not reply:
+                    return b""
+                data = self.port.read(reply + 2)
+                if len(data) == reply + 2 and crc16(data[:reply]) == int.from_bytes(data[reply:], "little"):
+                    return data[:reply]
+            elif status == REPLY_ERROR:
+                raise UploadError("page %d: rejected or verify failed" % page)
+            # the bootloader drops the frame after a timeout between bytes
+            time.sleep(0.1)
+        raise UploadError("page %d: no valid answer after %d tries" % (page, RETRIES))
+
+    def write(self, page, data):
+        self.command(b"W", page, data)
+
+    def read(self, page):
+        return self.command(b"R", page, reply=self.page_size)
+
+    def go(self):
+        self.command(b"G", 0)
+
+
+def progress(text, index, count):
+    print("\r%s %d/%d" % (text, index + 1, count), end="", flush=True)
+    if index + 1 == count:
+        print()
+
+
+def upload(bootloader, pages, verify):
+    blank = b"\xFF" * bootloader.page_size
+
+    # reset vector: erased first, written last
+    order = list(range(1, len(pages))) + [0]
+    bootloader.write(0, blank)
+    for index, page in enumerate(order):
+        bootloader.write(page, pages[page])
+        progress("writing page", index, len(order))
+
+    if verify:
+        for page in range(len(pages)):
+            if bootloader.read(page) != pages[page]:
+                bootloader.write(0, blank)
+                raise UploadError("page %d: verify failed, application is erased" % page)
+            progress("verifying page", page, len(pages))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("file", help="intel hex file of the application")
+    parser.add_argument("--port", required=True, help="serial port of usart 0 (needs pyserial)")
+    parser.add_argument("--baud", type=int, default=38400)
+    parser.add_argument("--wait", type=float, default=30, help="seconds to wait for the bootloader")
+    parser.add_argument("--no-console", action="store_true", help="don't send console command 'boot'")
+    parser.add_argument("--no-verify", action="store_true", help="don't read back all pages")
+    parser.add_argument("--no-start", action="store_true", help="stay in bootloader after the update")
+    args = parser.parse_args()
+
+    import serial
+
+    try:
+        memory = read_hex(args.file)
+    except UploadError as error:
+        print("error: %s" % error, file=sys.stderr)
+        return 1
+
+    port = serial.Serial(args.port, args.baud, timeout=1)
+    try:
+        if not args.no_console:
+            port.write(b"\rboot\r")
+            time.sleep(0.3)
+            port.reset_input_buffer()
+        print("waiting for bootloader (switch the clock off and on within %ds, if it doesn't start)"
+              % args.wait)
+        bootloader = Bootloader(port)
+        port.timeout = 0.05
+        version = bootloader.sync(args.wait)
+        port.timeout = 1
+        pages = split_pages(memory, bootloader.page_size)
+        if len(pages) > bootloader.pages:
+            raise UploadError("application has %d pages, the bootloader allows %d"
+                              % (len(pages), bootloader.pages))
+        print("bootloader version %d, %d pages of %d bytes" % (version, len(pages), bootloader.page_size))
+
+        start = time.time()
+        upload(bootloader, pages, not args.no_verify)
+        if not args.no_start:
+            bootloader.go()
+        print("done in %.1fs" % (time.time() - start))
+    except UploadError as error:
+        print("\nerror: %s" % error, file=sys.stderr)
+        return 1
+    finally:
+        port.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())